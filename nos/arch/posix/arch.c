@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2015  Electronics and Telecommunications Research Institute (ETRI) 
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file arch.c
+ * @brief POSIX host basic library
+ * @ingroup noslib_posix
+ * @copyright GNU General Public License v3
+ */
+
+#include "arch.h"
+#include "platform.h"
+#include "nos_rtc.h"
+#include "nos_timer.h"
+#include "vtime.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <malloc.h>
+
+
+#ifndef SYSCLK
+#error "SYSCLK should be defined in 'platform.h'."
+#endif
+
+
+UINT32 nested_intr_cnt;		// the number of nested interrupt (signal) handlers
+
+static sigset_t nos_hal_irq_set;	// signals treated as maskable interrupts
+
+void nos_arch_init(void)
+{
+	nested_intr_cnt = 0;
+
+	sigemptyset(&nos_hal_irq_set);
+	sigaddset(&nos_hal_irq_set, NOS_HAL_TICK_SIGNAL);
+#ifdef HRTIMER_M
+	sigaddset(&nos_hal_irq_set, NOS_HAL_HRTIMER_SIGNAL);
+#endif
+
+	/*
+	 * Serve every allocation from the brk heap. With a non-PIE executable it
+	 * sits right above .bss, i.e. below 4GB, so the kernel can keep storing
+	 * object pointers in UINT32 IDs.
+	 */
+	mallopt(M_MMAP_MAX, 0);
+
+	nos_rtc_init();
+
+	nos_timer_init();
+
+#ifdef UART_M
+	// I/O buffer initialization not to use buffering
+	setvbuf(stdout, NULL, _IONBF, 0);
+	setvbuf(stderr, NULL, _IONBF, 0);
+#endif
+}
+
+void system_abort(UINT8 ecode)
+{
+	fprintf(stderr, "\n## System Abort (%d) : Application Terminates\n\n", ecode);
+	exit(ecode);
+}
+
+#ifdef SIM_VIRTUAL_TIME
+bool nos_hal_irq_masked;
+#endif
+
+void nos_hal_irq_disable(void)
+{
+#ifdef SIM_VIRTUAL_TIME
+	nos_hal_irq_masked = TRUE;
+#else
+	sigprocmask(SIG_BLOCK, &nos_hal_irq_set, NULL);
+#endif
+}
+
+void nos_hal_irq_enable(void)
+{
+	// Handlers run with the tick signal blocked; it is unblocked by the
+	// signal return, just like PRIMASK is restored on exception return.
+	if (nested_intr_cnt == 0)
+	{
+#ifdef SIM_VIRTUAL_TIME
+		nos_hal_irq_masked = FALSE;
+		nos_vtime_poll();	// a tick that fell due while masked is taken now
+#else
+		sigprocmask(SIG_UNBLOCK, &nos_hal_irq_set, NULL);
+#endif
+	}
+}
+
+void nos_hal_wait_for_interrupt(void)
+{
+#ifdef SIM_VIRTUAL_TIME
+	nos_vtime_idle();	// fast-forwards to the next tick deadline
+#else
+	sigset_t none;
+
+	sigemptyset(&none);
+	sigsuspend(&none);	// returns after a handler has run
+#endif
+}
+
+
+uint16_t ntohs(uint16_t a)
+{
+    return (((a << 8) & 0xff00) | ((a >> 8) & 0xff));
+}
+
+uint32_t ntohl(uint32_t a)
+{
+    return (((a << 24) & 0xff000000) |
+            ((a << 8) & 0xff0000) |
+            ((a >> 8) & 0xff00) |
+            ((a >> 24) & 0xff));
+}
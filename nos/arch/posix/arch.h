@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2006-2015  Electronics and Telecommunications Research Institute (ETRI) 
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @defgroup noslib_posix
+ * @brief noslib - POSIX host "MCU" library
+ */
+
+/**
+ * @file arch.h
+ * @brief POSIX host basic header
+ * @ingroup noslib_posix
+ * @copyright GNU General Public License v3
+ *
+ * The whole system runs as one host process. Threads are ucontexts, the
+ * global interrupt flag is the signal mask and SysTick is an interval timer.
+ */
+
+
+#ifndef ARCH_H
+#define ARCH_H
+#include "kconf.h"
+
+#include <signal.h>
+#include <ucontext.h>
+#include "nos_common.h"
+#include "critical_section.h"
+#include "nos_timer.h"
+
+/* CMSIS-like keywords used by the portable sources */
+#ifndef __IO
+#define __IO	volatile
+#endif
+#ifndef __ASM
+#define __ASM	__asm__
+#endif
+#ifndef __INLINE
+#define __INLINE	inline
+#endif
+#define __NOP()	__ASM volatile ("nop")
+#define __WFI()	nos_hal_wait_for_interrupt()
+
+/* Endianess */
+#ifdef LITTLE_ENDIAN
+	#undef LITTLE_ENDIAN
+	#define LITTLE_ENDIAN   1
+#endif
+
+/* bit ordering */
+#define LSB_FIRST 1     // RS-232, ethernet
+#define BIT_ORDER_LITTLE_ENDIAN     LSB_FIRST
+
+/* Memory Align */
+#define ALIGN_MOD 4
+
+/*
+ * Host stacks also carry the signal frames of the tick handler and the libc
+ * stack usage of stdio, so they are much larger than on the MCU.
+ */
+#define DEFAULT_STACK_SIZE		(32 * 1024) // default stack size
+#define SYSTEM_STACK_SIZE		DEFAULT_STACK_SIZE // system thread stack size. Heap does not use this area
+/* The guard area right above the stack holds the thread's ucontext_t. */
+#define STACK_GUARD_SIZE		(sizeof(ucontext_t) + 32)
+
+/// MCU initialization.
+void nos_arch_init(void);
+void system_abort(UINT8 ecode);
+
+/// Sleep until the next interrupt (signal) has been handled.
+void nos_hal_wait_for_interrupt(void);
+
+/// System Reset
+#define NOS_RESET()                             \
+    do { \
+        exit(0); \
+    } while(0)
+
+
+
+///Convert 2-byte unsigned integer @p a from network to byte byte order.
+uint16_t ntohs(uint16_t a);
+
+///Convert 2-byte unsigned integer @p a from host to byte byte order.
+#define htons(a) ntohs(a)
+
+///Convert 4-byte unsigned integer @p a from network to host byte order.
+uint32_t ntohl(uint32_t a);
+
+///Convert 4-byte unsigned integer @p a from host to byte order.
+#define htonl(a) ntohl(a)
+
+
+#endif // ~ARCH_H
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2015  Electronics and Telecommunications Research Institute (ETRI) 
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file critical_section.h
+ * @brief Critical section for the POSIX host port
+ *
+ * PRIMASK is emulated by the process signal mask: disabling interrupts
+ * blocks the tick signal, enabling unblocks it. Inside a signal handler the
+ * tick signal is already blocked by the host, and re-enabling is deferred to
+ * the handler return (as an exception return would do on Cortex-M).
+ */
+
+
+#ifndef CRITICAL_SECTION_H
+#define CRITICAL_SECTION_H
+
+#include "nos_common.h"
+#include "intr.h"
+
+extern UINT32 nested_intr_cnt;		// the number of nested interrupt handlers
+extern INTR_STATUS intr_status;
+extern UINT32 os_sched_lock_level;
+
+void nos_hal_irq_disable(void);
+void nos_hal_irq_enable(void);
+
+#define NOS_DISABLE_GLOBAL_INTERRUPT() nos_hal_irq_disable()
+#define NOS_ENABLE_GLOBAL_INTERRUPT()  nos_hal_irq_enable()
+
+#define NOS_ENTER_CRITICAL_SECTION() \
+do { \
+	NOS_DISABLE_GLOBAL_INTERRUPT(); \
+	++os_sched_lock_level; \
+} while (0)
+
+#define NOS_EXIT_CRITICAL_SECTION() \
+do { \
+	--os_sched_lock_level; \
+	if (!os_sched_lock_level) \
+		NOS_ENABLE_GLOBAL_INTERRUPT(); \
+} while (0)
+
+#define NOS_IS_TASK_MODE() 	(!nested_intr_cnt)
+#define NOS_IS_ISR_MODE() 	(nested_intr_cnt>0)
+
+#endif	// CRITICAL_SECTION_H
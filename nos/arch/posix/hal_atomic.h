@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2015  Electronics and Telecommunications Research Institute (ETRI)
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file hal_atomic.h
+ * @brief Lock-free atomic operations for the POSIX host port (C11 <stdatomic.h>)
+ */
+
+#ifndef HAL_ATOMIC_H
+#define HAL_ATOMIC_H
+
+#include <stdatomic.h>
+#include "nos_common.h"
+
+typedef _Atomic UINT32 NOS_ATOMIC_U32;
+
+static inline UINT32 nos_atomic_load(NOS_ATOMIC_U32 *p)
+{
+	return atomic_load_explicit(p, memory_order_relaxed);
+}
+
+/// Loads made after it are not performed before it.
+static inline UINT32 nos_atomic_load_acquire(NOS_ATOMIC_U32 *p)
+{
+	return atomic_load_explicit(p, memory_order_acquire);
+}
+
+/// Stores made before it are visible before it.
+static inline void nos_atomic_store_release(NOS_ATOMIC_U32 *p, UINT32 v)
+{
+	atomic_store_explicit(p, v, memory_order_release);
+}
+
+/// Sets *p to desired if it holds expected. Returns TRUE on success.
+static inline BOOL nos_atomic_cas(NOS_ATOMIC_U32 *p, UINT32 expected, UINT32 desired)
+{
+	return atomic_compare_exchange_strong(p, &expected, desired) ? TRUE : FALSE;
+}
+
+/// Adds v to *p and returns the new value.
+static inline UINT32 nos_atomic_add(NOS_ATOMIC_U32 *p, UINT32 v)
+{
+	return atomic_fetch_add(p, v) + v;
+}
+
+#endif // HAL_ATOMIC_H
@@ -0,0 +1,112 @@
+// -*- c-file-style:"bsd"; c-basic-offset:4; indent-tabs-mode:nil; -*-
+/*
+ * Copyright (c) 2013
+ * Electronics and Telecommunications Research Institute (ETRI)
+ * All Rights Reserved.
+ *
+ * Following acts are STRICTLY PROHIBITED except when a specific prior written
+ * permission is obtained from ETRI or a separate written agreement with ETRI
+ * stipulates such permission specifically:
+ *
+ * a) Selling, distributing, sublicensing, renting, leasing, transmitting,
+ * redistributing or otherwise transferring this software to a third party;
+ *
+ * b) Copying, transforming, modifying, creating any derivatives of, reverse
+ * engineering, decompiling, disassembling, translating, making any attempt to
+ * discover the source code of, the whole or part of this software in source or
+ * binary form;
+ *
+ * c) Making any copy of the whole or part of this software other than one copy
+ * for backup purposes only; and
+ *
+ * d) Using the name, trademark or logo of ETRI or the names of contributors in
+ * order to endorse or promote products derived from this software.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITHOUT A WARRANTY OF ANY KIND. ALL
+ * EXPRESS OR IMPLIED CONDITIONS, REPRESENTATIONS AND WARRANTIES, INCLUDING ANY
+ * IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE OR
+ * NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI (OR ITS
+ * LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR
+ * DIRECT, INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES,
+ * HOWEVER CAUSED AND REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE USE OF OR INABILITY TO USE THIS SOFTWARE, EVEN
+ * IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * Any permitted redistribution of this software must retain the copyright
+ * notice, conditions, and disclaimer as specified above.
+ */
+
+/**
+ * @brief Context switching for the POSIX host (replaces hal_context.s).
+ *
+ * thread->context points to the thread's ucontext_t while the thread is
+ * switched out. Any other value (the initial frame set by thread_create(), or
+ * stack_bottom after a zero switch) means the thread must start over from
+ * thread_entry() on its own stack.
+ */
+
+#include "hal_thread.h"
+#ifdef THREAD_M
+
+#include "sched.h"
+#include "thread.h"
+
+#ifdef SIM_VIRTUAL_TIME
+// The signal mask of the ucontext does not cover the virtual PRIMASK flag.
+static void hal_thread_start(void)
+{
+    nos_hal_irq_masked = FALSE;
+    thread_entry();
+}
+#define HAL_THREAD_ENTRY	hal_thread_start
+#else
+#define HAL_THREAD_ENTRY	thread_entry
+#endif
+
+static ucontext_t *hal_thread_ucontext(THREAD *thread)
+{
+    // Never equal to stack_bottom, which the kernel uses to mark a dead context.
+    uintptr_t uc = (uintptr_t)thread->stack_bottom + 16;
+
+    return (ucontext_t *)((uc + 15) & ~(uintptr_t)15);
+}
+
+static ucontext_t *hal_thread_prepare(THREAD *thread)
+{
+    ucontext_t *uc = hal_thread_ucontext(thread);
+
+    if (thread->context != (CPUcontext *)uc)
+    {
+        getcontext(uc);
+        uc->uc_stack.ss_sp = thread->stack_start;
+        uc->uc_stack.ss_size = thread->stack_size;
+        uc->uc_link = NULL;
+        sigemptyset(&uc->uc_sigmask);	// a new thread starts with interrupts enabled
+        makecontext(uc, HAL_THREAD_ENTRY, 0);
+        thread->context = (CPUcontext *)uc;
+    }
+
+    return uc;
+}
+
+void os_switch_context(THREAD *prev, THREAD *next)
+{
+    ucontext_t *prev_uc = hal_thread_ucontext(prev);
+
+    prev->context = (CPUcontext *)prev_uc;
+    swapcontext(prev_uc, hal_thread_prepare(next));
+}
+
+void os_load_context(THREAD *thread)
+{
+    setcontext(hal_thread_prepare(thread));
+}
+
+void os_zero_switch_context(THREAD *prev, THREAD *next)
+{
+    // prev's stack is abandoned; it restarts from thread_entry() when it runs again.
+    (void)prev;
+    setcontext(hal_thread_prepare(next));
+}
+
+#endif // THREAD_M
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2015  Electronics and Telecommunications Research Institute (ETRI)
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file hal_hrtimer.c
+ * @brief Compare timer of the high-resolution timers (POSIX host)
+ */
+
+#include "kconf.h"
+
+#ifdef HRTIMER_M
+
+#include <signal.h>
+#include <time.h>
+
+#include "hal_hrtimer.h"
+#include "hal_sched.h"
+#include "critical_section.h"
+#include "nos_timer.h"
+#include "hrtimer.h"
+
+#ifdef SIM_VIRTUAL_TIME
+#error "HRTIMER_M needs the real-time host timers (SIM_VIRTUAL_TIME is set)"
+#endif
+
+static timer_t nos_hrtimer_hal_timer;
+static uint64_t nos_hrtimer_hal_boot_us;
+
+/* the compare interrupt entry, like nos_hal_tick_entry() */
+static void nos_hrtimer_hal_entry(int signo)
+{
+	(void)signo;
+
+	++nested_intr_cnt;
+	os_hrtimer_isr();
+	--nested_intr_cnt;
+
+	if (nos_hal_pendsv)
+	{
+		PendSV_Handler();
+	}
+}
+
+void nos_hrtimer_hal_init(void)
+{
+	struct sigaction sa;
+	struct sigevent sev;
+
+	sa.sa_handler = nos_hrtimer_hal_entry;
+	sigemptyset(&sa.sa_mask);
+	sigaddset(&sa.sa_mask, NOS_HAL_TICK_SIGNAL);
+	sa.sa_flags = SA_RESTART;
+	sigaction(NOS_HAL_HRTIMER_SIGNAL, &sa, NULL);
+
+	sev.sigev_notify = SIGEV_SIGNAL;
+	sev.sigev_signo = NOS_HAL_HRTIMER_SIGNAL;
+	sev.sigev_value.sival_ptr = NULL;
+	timer_create(CLOCK_MONOTONIC, &sev, &nos_hrtimer_hal_timer);
+
+	nos_hrtimer_hal_boot_us = nos_timer_host_us();
+}
+
+UINT32 nos_hrtimer_hal_now(void)
+{
+	return (UINT32)(nos_timer_host_us() - nos_hrtimer_hal_boot_us);
+}
+
+void nos_hrtimer_hal_set(UINT32 when)
+{
+	struct itimerspec its = { { 0, 0 }, { 0, 0 } };
+	INT32 delta = (INT32)(when - nos_hrtimer_hal_now());
+
+	if (delta < 1)
+	{
+		delta = 1;	// a zero value would disarm the timer
+	}
+	its.it_value.tv_sec = delta / 1000000;
+	its.it_value.tv_nsec = (delta % 1000000) * 1000;
+	timer_settime(nos_hrtimer_hal_timer, 0, &its, NULL);
+}
+
+void nos_hrtimer_hal_stop(void)
+{
+	struct itimerspec its = { { 0, 0 }, { 0, 0 } };
+
+	timer_settime(nos_hrtimer_hal_timer, 0, &its, NULL);
+}
+
+#endif // HRTIMER_M
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2015  Electronics and Telecommunications Research Institute (ETRI)
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file hal_hrtimer.h
+ * @brief Compare timer of the high-resolution timers (POSIX host)
+ *
+ * The counter is CLOCK_MONOTONIC in microseconds since nos_hrtimer_hal_init().
+ * The compare interrupt is a one-shot POSIX timer raising
+ * NOS_HAL_HRTIMER_SIGNAL, masked together with the tick signal.
+ */
+
+#ifndef HAL_HRTIMER_H
+#define HAL_HRTIMER_H
+
+#include "kconf.h"
+#include "nos_common.h"
+
+void nos_hrtimer_hal_init(void);
+
+/// Current counter value (us).
+UINT32 nos_hrtimer_hal_now(void);
+
+/// Interrupt at @p when, or right away if @p when has passed.
+void nos_hrtimer_hal_set(UINT32 when);
+void nos_hrtimer_hal_stop(void);
+
+#endif // HAL_HRTIMER_H
@@ -0,0 +1,95 @@
+// -*- c-file-style:"bsd"; c-basic-offset:4; indent-tabs-mode:nil; -*-
+/*
+ * Copyright (c) 2013
+ * Electronics and Telecommunications Research Institute (ETRI)
+ * All Rights Reserved.
+ *
+ * Following acts are STRICTLY PROHIBITED except when a specific prior written
+ * permission is obtained from ETRI or a separate written agreement with ETRI
+ * stipulates such permission specifically:
+ *
+ * a) Selling, distributing, sublicensing, renting, leasing, transmitting,
+ * redistributing or otherwise transferring this software to a third party;
+ *
+ * b) Copying, transforming, modifying, creating any derivatives of, reverse
+ * engineering, decompiling, disassembling, translating, making any attempt to
+ * discover the source code of, the whole or part of this software in source or
+ * binary form;
+ *
+ * c) Making any copy of the whole or part of this software other than one copy
+ * for backup purposes only; and
+ *
+ * d) Using the name, trademark or logo of ETRI or the names of contributors in
+ * order to endorse or promote products derived from this software.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITHOUT A WARRANTY OF ANY KIND. ALL
+ * EXPRESS OR IMPLIED CONDITIONS, REPRESENTATIONS AND WARRANTIES, INCLUDING ANY
+ * IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE OR
+ * NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI (OR ITS
+ * LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR
+ * DIRECT, INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES,
+ * HOWEVER CAUSED AND REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE USE OF OR INABILITY TO USE THIS SOFTWARE, EVEN
+ * IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * Any permitted redistribution of this software must retain the copyright
+ * notice, conditions, and disclaimer as specified above.
+ */
+
+/**
+ * Scheduler HAL (POSIX host)
+ *
+ * The tick signal handler is the "exception entry": it marks ISR mode,
+ * runs the platform SysTick handler and, like a tail-chained PendSV on
+ * Cortex-M, performs a pending context switch before returning.
+ */
+#include "critical_section.h"
+#include "hal_sched.h"
+#include "platform.h"
+#include "nos_timer.h"
+
+#ifdef KERNEL_M
+
+volatile UINT32 nos_hal_pendsv;
+
+static void nos_hal_tick_entry(int signo)
+{
+    (void)signo;
+
+    ++nested_intr_cnt;
+    SysTick_Handler();
+    --nested_intr_cnt;
+
+    if (nos_hal_pendsv)
+    {
+        PendSV_Handler();
+    }
+}
+
+void nos_sched_hal_init(void)
+{
+    struct sigaction sa;
+
+    sa.sa_handler = nos_hal_tick_entry;
+    sigemptyset(&sa.sa_mask);
+#ifdef HRTIMER_M
+    sigaddset(&sa.sa_mask, NOS_HAL_HRTIMER_SIGNAL);
+#endif
+    sa.sa_flags = SA_RESTART;
+    sigaction(NOS_HAL_TICK_SIGNAL, &sa, NULL);
+
+    /* Init PendSV */
+    NOS_CTX_SW_PENDING_CLEAR();
+
+#ifndef SCHED_TICKLESS
+    /* the tick runs from now on, with no deadline yet */
+    os_timer_tick_stop();
+#endif
+}
+
+void nos_sched_timer_start(void)
+{
+    //Nothing to do. The tick is armed by os_timer_tick_set().
+}
+
+#endif // KERNEL_M
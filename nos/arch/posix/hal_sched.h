@@ -0,0 +1,93 @@
+// -*- c-file-style:"bsd"; c-basic-offset:4; indent-tabs-mode:nil; -*-
+/*
+ * Copyright (c) 2013
+ * Electronics and Telecommunications Research Institute (ETRI)
+ * All Rights Reserved.
+ *
+ * Following acts are STRICTLY PROHIBITED except when a specific prior written
+ * permission is obtained from ETRI or a separate written agreement with ETRI
+ * stipulates such permission specifically:
+ *
+ * a) Selling, distributing, sublicensing, renting, leasing, transmitting,
+ * redistributing or otherwise transferring this software to a third party;
+ *
+ * b) Copying, transforming, modifying, creating any derivatives of, reverse
+ * engineering, decompiling, disassembling, translating, making any attempt to
+ * discover the source code of, the whole or part of this software in source or
+ * binary form;
+ *
+ * c) Making any copy of the whole or part of this software other than one copy
+ * for backup purposes only; and
+ *
+ * d) Using the name, trademark or logo of ETRI or the names of contributors in
+ * order to endorse or promote products derived from this software.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITHOUT A WARRANTY OF ANY KIND. ALL
+ * EXPRESS OR IMPLIED CONDITIONS, REPRESENTATIONS AND WARRANTIES, INCLUDING ANY
+ * IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE OR
+ * NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI (OR ITS
+ * LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR
+ * DIRECT, INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES,
+ * HOWEVER CAUSED AND REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE USE OF OR INABILITY TO USE THIS SOFTWARE, EVEN
+ * IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * Any permitted redistribution of this software must retain the copyright
+ * notice, conditions, and disclaimer as specified above.
+ */
+
+/**
+ * HAL for scheduler (POSIX host).
+ *
+ * SysTick is emulated with a one-shot ITIMER_REAL and SIGALRM, PendSV with a
+ * flag that the signal entry code checks before returning to the thread.
+ */
+
+#ifndef __HAL_SCHED_H__
+#define __HAL_SCHED_H__
+
+#include "kconf.h"
+
+#ifdef KERNEL_M
+
+#include "nos_common.h"
+
+// Note that changing this value does not mean channging tick interrupt interval.
+#ifdef SCHED_PERIOD_5
+#define SCHED_TIMER_MS          5
+#elif defined SCHED_PERIOD_10
+#define SCHED_TIMER_MS          10
+#elif defined SCHED_PERIOD_32
+#define SCHED_TIMER_MS          32
+#elif defined SCHED_PERIOD_100
+#define SCHED_TIMER_MS          100
+#else
+#error "Unknown scheduling time slice"
+#endif
+
+extern volatile UINT32 nos_hal_pendsv;
+
+// Count leading zeros, used by the ready queue and tick_q.
+#define NOS_CLZ(x)              __builtin_clz(x)
+
+#define KERNEL_DEFERRED_CTX_SW 1
+#define NOS_CTX_SW_PENDING_SET() \
+    do { nos_hal_pendsv = 1; } while (0)
+#define NOS_CTX_SW_PENDING_CLEAR() \
+    do { nos_hal_pendsv = 0; } while (0)
+
+void nos_sched_hal_init(void);
+void nos_sched_timer_start(void);
+extern void (*sched_callback)(void);	// this varable indicates the scheduler is working or not.
+
+// Exception handlers, provided by the platform (cf. stm32f4xx_it.c).
+void SysTick_Handler(void);
+void PendSV_Handler(void);
+
+//@phj.
+#define SEC(x)	((x)*(100))
+#define MSEC(x)	((x+9)/10)
+
+
+#endif // KERNEL_M
+#endif // __!HAL_SCHED_H__
@@ -0,0 +1,67 @@
+// -*- c-file-style:"bsd"; c-basic-offset:4; indent-tabs-mode:nil; -*-
+/*
+ * Copyright (c) 2013
+ * Electronics and Telecommunications Research Institute (ETRI)
+ * All Rights Reserved.
+ *
+ * Following acts are STRICTLY PROHIBITED except when a specific prior written
+ * permission is obtained from ETRI or a separate written agreement with ETRI
+ * stipulates such permission specifically:
+ *
+ * a) Selling, distributing, sublicensing, renting, leasing, transmitting,
+ * redistributing or otherwise transferring this software to a third party;
+ *
+ * b) Copying, transforming, modifying, creating any derivatives of, reverse
+ * engineering, decompiling, disassembling, translating, making any attempt to
+ * discover the source code of, the whole or part of this software in source or
+ * binary form;
+ *
+ * c) Making any copy of the whole or part of this software other than one copy
+ * for backup purposes only; and
+ *
+ * d) Using the name, trademark or logo of ETRI or the names of contributors in
+ * order to endorse or promote products derived from this software.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITHOUT A WARRANTY OF ANY KIND. ALL
+ * EXPRESS OR IMPLIED CONDITIONS, REPRESENTATIONS AND WARRANTIES, INCLUDING ANY
+ * IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE OR
+ * NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI (OR ITS
+ * LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR
+ * DIRECT, INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES,
+ * HOWEVER CAUSED AND REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE USE OF OR INABILITY TO USE THIS SOFTWARE, EVEN
+ * IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * Any permitted redistribution of this software must retain the copyright
+ * notice, conditions, and disclaimer as specified above.
+ */
+
+/**
+ * @brief HAL for threads (POSIX host).
+ */
+
+#ifndef __HAL_THREAD_H__
+#define __HAL_THREAD_H__
+#include "kconf.h"
+#ifdef KERNEL_M
+
+#include "nos_common.h"
+#include "arch.h"
+
+typedef MEMENTRY_T STACK_ENTRY; // The stack is 4 byte-contiguous array
+typedef MEMENTRY_T *STACK_PTR;  // stack pointer (32 bit wide entries)
+
+#ifdef THREAD_M
+
+#define stack_bottom(thread)	(thread->stack_start + (thread->stack_size >> 2))
+
+/*
+ * A host thread context is a ucontext_t kept in the stack guard area right
+ * above stack_bottom. It is built lazily by the first switch to the thread,
+ * so the register frame the kernel reserves below stack_bottom stays unused.
+ */
+#define os_thread_context_init(context)	((void)(context))
+
+#endif // THREAD_M
+#endif // KERNEL_M
+#endif // !__HAL_THREAD_H__
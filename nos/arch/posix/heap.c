@@ -0,0 +1,285 @@
+// -*- c-file-style:"bsd"; c-basic-offset:4; indent-tabs-mode:nil; -*-
+/*
+ * Copyright (c) 2014
+ * Electronics and Telecommunications Research Institute (ETRI)
+ * All Rights Reserved.
+ *
+ * Following acts are STRICTLY PROHIBITED except when a specific prior written
+ * permission is obtained from ETRI or a separate written agreement with ETRI
+ * stipulates such permission specifically:
+ *
+ * a) Selling, distributing, sublicensing, renting, leasing, transmitting,
+ * redistributing or otherwise transferring this software to a third party;
+ *
+ * b) Copying, transforming, modifying, creating any derivatives of, reverse
+ * engineering, decompiling, disassembling, translating, making any attempt to
+ * discover the source code of, the whole or part of this software in source or
+ * binary form;
+ *
+ * c) Making any copy of the whole or part of this software other than one copy
+ * for backup purposes only; and
+ *
+ * d) Using the name, trademark or logo of ETRI or the names of contributors in
+ * order to endorse or promote products derived from this software.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITHOUT A WARRANTY OF ANY KIND. ALL
+ * EXPRESS OR IMPLIED CONDITIONS, REPRESENTATIONS AND WARRANTIES, INCLUDING ANY
+ * IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE OR
+ * NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI (OR ITS
+ * LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR
+ * DIRECT, INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES,
+ * HOWEVER CAUSED AND REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE USE OF OR INABILITY TO USE THIS SOFTWARE, EVEN
+ * IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * Any permitted redistribution of this software must retain the copyright
+ * notice, conditions, and disclaimer as specified above.
+ */
+
+/**
+ * Dynamic memory functions' overridden to debug (POSIX host)
+ *
+ * The host libc malloc() is used like newlib's on the MCU. nos_arch_init()
+ * keeps it on the brk heap, which lies below 4GB; a block that does not is
+ * refused because it could not be named by a UINT32 object ID.
+ *
+ * @author Jongsoo Jeong (ETRI)
+ * @date 2014. 2. 11.
+ */
+
+#include "kconf.h"
+
+#include "heap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "arch.h"
+#include "critical_section.h"
+
+#ifdef HEAP_TLSF
+/*
+ * TLSF over the brk heap, grown by sbrk() like newlib does on the MCU. The
+ * critical section only covers the allocator, which runs in bounded time.
+ */
+#ifndef CONFIG_HEAP_TLSF_GROW
+#define CONFIG_HEAP_TLSF_GROW   4096
+#endif
+
+static TLSF os_heap;    /* zeroed: empty */
+
+#ifdef HEAP_REGIONS
+/*
+ * Stand-ins for the CCM and the backup SRAM heaps of the MCU. Host stacks
+ * are 32 KB larger (arch.h), so both are scaled up to hold as many threads.
+ */
+#ifndef CONFIG_HEAP_BKPSRAM_SIZE
+#define CONFIG_HEAP_BKPSRAM_SIZE    1024
+#endif
+#define HEAP_HOST_SCALE         32
+
+static UINT8 os_ccm_mem[64 * 1024 * HEAP_HOST_SCALE] __attribute__((aligned(TLSF_ALIGN)));
+static UINT8 os_bkpsram_mem[CONFIG_HEAP_BKPSRAM_SIZE * HEAP_HOST_SCALE] __attribute__((aligned(TLSF_ALIGN)));
+
+static TLSF os_heap_ccm, os_heap_bkpsram;
+
+/* the heap of a region, set up on first use; NULL if there is none */
+static TLSF *os_heap_region(UINT32 region)
+{
+    static BOOL ready;
+
+    if (!ready)
+    {
+        tlsf_add_pool(&os_heap_ccm, os_ccm_mem, sizeof(os_ccm_mem));
+        tlsf_add_pool(&os_heap_bkpsram, os_bkpsram_mem, sizeof(os_bkpsram_mem));
+        ready = TRUE;
+    }
+
+    switch (region)
+    {
+    case MEM_SRAM:
+        return &os_heap;
+    case MEM_CCM:
+        return &os_heap_ccm;
+    case MEM_BKPSRAM:
+        return &os_heap_bkpsram;
+    }
+    return NULL;
+}
+
+/* the heap of a block, by its address */
+static TLSF *os_heap_of(void *ptr)
+{
+    UINT8 *p = ptr;
+
+    if ((p >= os_ccm_mem) && (p < os_ccm_mem + sizeof(os_ccm_mem)))
+    {
+        return &os_heap_ccm;
+    }
+    if ((p >= os_bkpsram_mem) && (p < os_bkpsram_mem + sizeof(os_bkpsram_mem)))
+    {
+        return &os_heap_bkpsram;
+    }
+    return &os_heap;
+}
+#else
+#define os_heap_of(ptr)         (&os_heap)
+#endif
+
+static BOOL os_heap_grow(UINT32 len)
+{
+    UINT32 bytes = tlsf_pool_size(len);
+    void *mem;
+
+    if (bytes == 0)
+    {
+        return FALSE;
+    }
+    if (bytes < CONFIG_HEAP_TLSF_GROW)
+    {
+        bytes = CONFIG_HEAP_TLSF_GROW;
+    }
+    bytes = (bytes + TLSF_ALIGN - 1) & ~(TLSF_ALIGN - 1);
+
+    mem = sbrk(bytes);
+    if ((mem == (void *)-1) || ((uintptr_t)mem + bytes > UINT32_MAX))
+    {
+        return FALSE;
+    }
+    return tlsf_add_pool(&os_heap, mem, bytes);
+}
+
+/* only the main heap grows */
+static void *os_heap_malloc(TLSF *heap, UINT32 len)
+{
+    void *ptr = tlsf_malloc(heap, len);
+
+    if ((ptr == NULL) && (heap == &os_heap) && os_heap_grow(len))
+    {
+        ptr = tlsf_malloc(heap, len);
+    }
+    return ptr;
+}
+
+void *nos_malloc(UINT32 len)
+{
+    void *ptr;
+
+    NOS_ENTER_CRITICAL_SECTION();
+    ptr = os_heap_malloc(&os_heap, len);
+#ifdef HEAP_PROFILE
+    os_heap_profile_alloc(ptr, len, __builtin_return_address(0));
+#endif
+#ifdef HEAP_DEBUG
+    printf("%s()-len:%u, ptr:0x%p\n\r", __FUNCTION__, len, ptr);
+#endif
+    NOS_EXIT_CRITICAL_SECTION();
+
+    return ptr;
+}
+
+void nos_free(void *ptr)
+{
+    BOOL ok;
+
+    NOS_ENTER_CRITICAL_SECTION();
+#ifdef HEAP_DEBUG
+    printf("%s()-ptr:0x%p\n\r", __FUNCTION__, ptr);
+#endif
+    ok = tlsf_free(os_heap_of(ptr), ptr);
+#ifdef HEAP_PROFILE
+    if (ok)
+    {
+        os_heap_profile_free(ptr);
+    }
+#endif
+    NOS_EXIT_CRITICAL_SECTION();
+
+    if (!ok)
+    {
+        fprintf(stderr, "nos_free(%p): bad block\n", ptr);
+        system_abort(0);
+    }
+}
+
+void nos_heap_get_stats(TLSF_STATS *stats)
+{
+    NOS_ENTER_CRITICAL_SECTION();
+    tlsf_get_stats(&os_heap, stats);
+    NOS_EXIT_CRITICAL_SECTION();
+}
+
+#ifdef HEAP_REGIONS
+/* NULL when the region is full: the caller decides about another one */
+void *nos_malloc_region(UINT32 region, UINT32 len)
+{
+    TLSF *heap;
+    void *ptr = NULL;
+
+    NOS_ENTER_CRITICAL_SECTION();
+    if ((heap = os_heap_region(region)) != NULL)
+    {
+        ptr = os_heap_malloc(heap, len);
+    }
+#ifdef HEAP_PROFILE
+    os_heap_profile_alloc(ptr, len, __builtin_return_address(0));
+#endif
+#ifdef HEAP_DEBUG
+    printf("%s()-region:%u, len:%u, ptr:0x%p\n\r", __FUNCTION__, region, len, ptr);
+#endif
+    NOS_EXIT_CRITICAL_SECTION();
+
+    return ptr;
+}
+
+void nos_heap_get_region_stats(UINT32 region, TLSF_STATS *stats)
+{
+    TLSF *heap;
+
+    NOS_ENTER_CRITICAL_SECTION();
+    if ((heap = os_heap_region(region)) != NULL)
+    {
+        tlsf_get_stats(heap, stats);
+    }
+    else
+    {
+        memset(stats, 0, sizeof(TLSF_STATS));
+    }
+    NOS_EXIT_CRITICAL_SECTION();
+}
+#endif
+
+#else
+
+void *nos_malloc(UINT32 len)
+{
+    void *ptr;
+    
+    NOS_ENTER_CRITICAL_SECTION();
+    ptr = malloc(len);
+    if ((uintptr_t)ptr + len > UINT32_MAX)
+    {
+        free(ptr);
+        ptr = NULL;
+    }
+    
+#ifdef HEAP_DEBUG
+    printf("%s()-len:%u, ptr:0x%p\n\r", __FUNCTION__, len, ptr);
+#endif
+    NOS_EXIT_CRITICAL_SECTION();
+
+    return ptr;
+}
+
+void nos_free(void *ptr)
+{
+    NOS_ENTER_CRITICAL_SECTION();
+#ifdef HEAP_DEBUG
+    printf("%s()-ptr:0x%p\n\r", __FUNCTION__, ptr);
+#endif
+    
+    free(ptr);
+    NOS_EXIT_CRITICAL_SECTION();
+}
+
+#endif // HEAP_TLSF
@@ -0,0 +1,86 @@
+// -*- c-file-style:"bsd"; c-basic-offset:4; indent-tabs-mode:nil; -*-
+/*
+ * Copyright (c) 2014
+ * Electronics and Telecommunications Research Institute (ETRI)
+ * All Rights Reserved.
+ *
+ * Following acts are STRICTLY PROHIBITED except when a specific prior written
+ * permission is obtained from ETRI or a separate written agreement with ETRI
+ * stipulates such permission specifically:
+ *
+ * a) Selling, distributing, sublicensing, renting, leasing, transmitting,
+ * redistributing or otherwise transferring this software to a third party;
+ *
+ * b) Copying, transforming, modifying, creating any derivatives of, reverse
+ * engineering, decompiling, disassembling, translating, making any attempt to
+ * discover the source code of, the whole or part of this software in source or
+ * binary form;
+ *
+ * c) Making any copy of the whole or part of this software other than one copy
+ * for backup purposes only; and
+ *
+ * d) Using the name, trademark or logo of ETRI or the names of contributors in
+ * order to endorse or promote products derived from this software.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITHOUT A WARRANTY OF ANY KIND. ALL
+ * EXPRESS OR IMPLIED CONDITIONS, REPRESENTATIONS AND WARRANTIES, INCLUDING ANY
+ * IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE OR
+ * NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI (OR ITS
+ * LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR
+ * DIRECT, INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES,
+ * HOWEVER CAUSED AND REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE USE OF OR INABILITY TO USE THIS SOFTWARE, EVEN
+ * IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * Any permitted redistribution of this software must retain the copyright
+ * notice, conditions, and disclaimer as specified above.
+ */
+
+/**
+ * Dynamic memory functions' wrapper.
+ *
+ * @author Jongsoo Jeong (ETRI)
+ * @date 2014. 2. 11.
+ */
+
+#ifndef HEAP_H
+#define HEAP_H
+
+#include "kconf.h"
+#include "nos_common.h"
+
+void *nos_malloc(UINT32 len);
+void nos_free(void *ptr);
+
+#ifdef HEAP_TLSF
+#include "tlsf.h"
+
+void nos_heap_get_stats(TLSF_STATS *stats);
+#endif
+
+#ifdef HEAP_REGIONS
+/*
+ * Memory regions of nos_malloc_region(), as on the MCU. The host has no CCM
+ * or backup SRAM: both are static arrays here, so only the allocation
+ * behaviour is the same. nos_free() takes a block of any region.
+ */
+enum
+{
+    MEM_SRAM,
+    MEM_CCM,
+    MEM_BKPSRAM,
+    MEM_REGIONS
+};
+
+void *nos_malloc_region(UINT32 region, UINT32 len);
+void nos_heap_get_region_stats(UINT32 region, TLSF_STATS *stats);
+#endif
+
+/* no CCM on the host: an ordinary variable */
+#define MEM_CCM_ATTR
+
+#ifdef HEAP_PROFILE
+#include "heap_profile.h"
+#endif
+
+#endif /* HEAP_H */
@@ -0,0 +1,36 @@
+//===================================================================
+//
+// intr.h (@sheart)
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+#ifndef INTR_H
+#define INTR_H
+#include "kconf.h"
+#include "nos_common.h"
+#include "hardware.h"
+
+#include <signal.h>
+
+// On the host, an "interrupt" is a signal delivered to the process.
+// SIGALRM plays the role of SysTick (see hal_sched.c).
+#define NOS_HAL_TICK_SIGNAL	SIGALRM
+// SIGUSR1 is the compare interrupt of the high-resolution timers (TIM2).
+#define NOS_HAL_HRTIMER_SIGNAL	SIGUSR1
+
+extern UINT32 nested_intr_cnt;		// the number of nested interrupt (signal) handlers
+
+#ifdef SIM_VIRTUAL_TIME
+// With virtual time there is no tick signal; PRIMASK is a plain flag.
+extern bool nos_hal_irq_masked;
+#endif
+
+// Functions and Variables
+typedef struct _intr_status
+{
+	UINT32 cnt;
+} INTR_STATUS;
+
+
+#endif	// ~INTR_H
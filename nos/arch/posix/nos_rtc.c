@@ -0,0 +1,92 @@
+// -*- c-file-style:"bsd"; c-basic-offset:4; indent-tabs-mode:nil; -*-
+/*
+ * Copyright (c) 2013
+ * Electronics and Telecommunications Research Institute (ETRI)
+ * All Rights Reserved.
+ *
+ * Following acts are STRICTLY PROHIBITED except when a specific prior written
+ * permission is obtained from ETRI or a separate written agreement with ETRI
+ * stipulates such permission specifically:
+ *
+ * a) Selling, distributing, sublicensing, renting, leasing, transmitting,
+ * redistributing or otherwise transferring this software to a third party;
+ *
+ * b) Copying, transforming, modifying, creating any derivatives of, reverse
+ * engineering, decompiling, disassembling, translating, making any attempt to
+ * discover the source code of, the whole or part of this software in source or
+ * binary form;
+ *
+ * c) Making any copy of the whole or part of this software other than one copy
+ * for backup purposes only; and
+ *
+ * d) Using the name, trademark or logo of ETRI or the names of contributors in
+ * order to endorse or promote products derived from this software.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITHOUT A WARRANTY OF ANY KIND. ALL
+ * EXPRESS OR IMPLIED CONDITIONS, REPRESENTATIONS AND WARRANTIES, INCLUDING ANY
+ * IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE OR
+ * NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI (OR ITS
+ * LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR
+ * DIRECT, INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES,
+ * HOWEVER CAUSED AND REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE USE OF OR INABILITY TO USE THIS SOFTWARE, EVEN
+ * IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * Any permitted redistribution of this software must retain the copyright
+ * notice, conditions, and disclaimer as specified above.
+ */
+
+/**
+ * Realtime clock (POSIX host): seconds counter on top of CLOCK_REALTIME
+ * (or the virtual clock with SIM_VIRTUAL_TIME).
+ * Alarms are not wired up, as on the STM32F4 port.
+ */
+
+#include "kconf.h"
+
+#include <time.h>
+#include "nos_rtc.h"
+#include "nos_timer.h"
+
+static int64_t nos_rtc_offset;	// counter value - host seconds
+
+
+static int64_t nos_rtc_host_sec(void)
+{
+#ifdef SIM_VIRTUAL_TIME
+    return (int64_t)(nos_timer_host_us() / 1000000);
+#else
+    return (int64_t)time(NULL);
+#endif
+}
+
+
+void nos_rtc_init(void)
+{
+    nos_rtc_set_time(0);
+}
+
+void nos_rtc_set_time(uint32_t sec)
+{
+    nos_rtc_offset = (int64_t)sec - nos_rtc_host_sec();
+}
+
+uint32_t nos_rtc_get_time(void)
+{
+    return (uint32_t)(nos_rtc_host_sec() + nos_rtc_offset);
+}
+
+/* Set the RTC Periodic Alarm */
+int nos_rtc_set_alarm(uint32_t sec_period, void (*func)(void*), void* args, bool oneshot)
+{
+    return 0;
+}
+
+void nos_rtc_release_alarm(void)
+{
+}
+
+/* Enable/Disable the RTC Second Interrupt */
+void nos_rtc_enable_sec_intr(bool en)
+{
+}
@@ -0,0 +1,357 @@
+// -*- c-file-style:"bsd"; c-basic-offset:4; indent-tabs-mode:nil; -*-
+/*
+ * Copyright (c) 2013
+ * Electronics and Telecommunications Research Institute (ETRI)
+ * All Rights Reserved.
+ *
+ * Following acts are STRICTLY PROHIBITED except when a specific prior written
+ * permission is obtained from ETRI or a separate written agreement with ETRI
+ * stipulates such permission specifically:
+ *
+ * a) Selling, distributing, sublicensing, renting, leasing, transmitting,
+ * redistributing or otherwise transferring this software to a third party;
+ *
+ * b) Copying, transforming, modifying, creating any derivatives of, reverse
+ * engineering, decompiling, disassembling, translating, making any attempt to
+ * discover the source code of, the whole or part of this software in source or
+ * binary form;
+ *
+ * c) Making any copy of the whole or part of this software other than one copy
+ * for backup purposes only; and
+ *
+ * d) Using the name, trademark or logo of ETRI or the names of contributors in
+ * order to endorse or promote products derived from this software.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITHOUT A WARRANTY OF ANY KIND. ALL
+ * EXPRESS OR IMPLIED CONDITIONS, REPRESENTATIONS AND WARRANTIES, INCLUDING ANY
+ * IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE OR
+ * NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI (OR ITS
+ * LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR
+ * DIRECT, INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES,
+ * HOWEVER CAUSED AND REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE USE OF OR INABILITY TO USE THIS SOFTWARE, EVEN
+ * IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * Any permitted redistribution of this software must retain the copyright
+ * notice, conditions, and disclaimer as specified above.
+ */
+
+/**
+ * @file nos_timer.c
+ * @brief Timers of the POSIX host port
+ *
+ * The scheduler tick (SysTick on the MCU) is a one-shot ITIMER_REAL that
+ * raises SIGALRM. The general purpose channels and the measuring timer
+ * (TIM5 on the MCU) are read from CLOCK_MONOTONIC.
+ *
+ * With SIM_VIRTUAL_TIME all of them run on the virtual clock of vtime.c
+ * instead, and the tick deadline is handed over to it.
+ */
+
+#include "nos.h"
+#include "kconf.h"
+
+#include <time.h>
+#include <sys/time.h>
+
+#include "nos_timer.h"
+#include "hal_sched.h"
+#include "vtime.h"
+
+
+extern __IO uint32_t MeasureTimer_CNT;
+
+UINT32 __gcounter;
+UINT32 __saved_alid;
+
+static uint32_t nos_hal_timer_range_us[NOS_TIMER_NUM];
+static uint64_t nos_hal_timer_start_us[NOS_TIMER_NUM];
+
+static uint64_t os_timer_boot_us;       // host time at nos_timer_init()
+
+static uint64_t MT_start_us;
+static uint64_t MT_elapsed_us;
+static bool MT_running;
+
+
+uint64_t nos_timer_host_us(void)
+{
+#ifdef SIM_VIRTUAL_TIME
+    return nos_vtime_now_us();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+void nos_timer_init(void)
+{
+    int i;
+
+    for (i = 0; i < NOS_TIMER_NUM; i++)
+    {
+        nos_hal_timer_range_us[i] = 0;
+    }
+
+    os_timer_boot_us = nos_timer_host_us();
+}
+
+bool nos_timer_is_set(int timer_channel)
+{
+    return (nos_hal_timer_range_us[timer_channel] != 0);
+}
+
+int nos_timer_config(int timer_channel, uint32_t us)
+{
+    if (timer_channel < 0 || timer_channel >= NOS_TIMER_NUM || us == 0)
+    {
+        return EXIT_FAIL;
+    }
+
+    nos_hal_timer_range_us[timer_channel] = us;
+    return EXIT_SUCCESS;
+}
+
+int nos_timer_start(int timer_channel)
+{
+    if (timer_channel < 0 || timer_channel >= NOS_TIMER_NUM)
+    {
+        return EXIT_FAIL;
+    }
+
+    // not configured timer
+    if (nos_hal_timer_range_us[timer_channel] == 0)
+    {
+        return EXIT_FAIL;
+    }
+
+    nos_hal_timer_start_us[timer_channel] = nos_timer_host_us();
+    return EXIT_SUCCESS;
+}
+
+bool nos_timer_expired(int timer_channel)
+{
+    uint64_t now = nos_timer_host_us();
+
+    if (!nos_timer_is_set(timer_channel))
+    {
+        return FALSE;
+    }
+
+    if (now - nos_hal_timer_start_us[timer_channel] >= nos_hal_timer_range_us[timer_channel])
+    {
+        // The hardware timer reloads on update; so does this one.
+        nos_hal_timer_start_us[timer_channel] = now;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+uint32_t nos_timer_get_time(int timer_channel)
+{
+    if (!nos_timer_is_set(timer_channel))
+    {
+        return 0;
+    }
+    return (uint32_t)(nos_timer_host_us() - nos_hal_timer_start_us[timer_channel]);
+}
+
+void nos_timer_release(int timer_channel)
+{
+    if (timer_channel >= 0 && timer_channel < NOS_TIMER_NUM)
+    {
+        nos_hal_timer_range_us[timer_channel] = 0;
+    }
+}
+
+/*
+ * Scheduler tick
+ *
+ * Tick deadlines are kept on the grid of the tick period, counted from
+ * nos_timer_init(), so reprogramming the timer never shifts the ticks. The
+ * host timer is one-shot and re-armed for every tick, and the deadline is
+ * only compared; with SCHED_TICKLESS it is armed for the deadline only.
+ */
+#define OS_TIMER_TICK_US    (SCHED_TIMER_MS * 1000)
+
+static uint64_t os_timer_deadline_us;   // since boot
+static bool os_timer_armed;
+
+#ifndef SIM_VIRTUAL_TIME
+/*
+ * Reprogramming the tick timer cancels the previous deadline. A signal of
+ * that deadline may already be pending (the callers run with it blocked);
+ * drop it so that it is not taken for the new deadline.
+ */
+static void os_timer_tick_clear_pending(void)
+{
+    static const struct timespec no_wait = { 0, 0 };
+    sigset_t pending, tick_set;
+
+    sigpending(&pending);
+    if (sigismember(&pending, NOS_HAL_TICK_SIGNAL))
+    {
+        sigemptyset(&tick_set);
+        sigaddset(&tick_set, NOS_HAL_TICK_SIGNAL);
+        sigtimedwait(&tick_set, NULL, &no_wait);
+    }
+}
+#endif
+
+// Programs the host timer for @at (since boot), or cancels it.
+static void os_timer_host_arm(bool arm, uint64_t at)
+{
+#ifdef SIM_VIRTUAL_TIME
+    if (arm)
+    {
+        nos_vtime_arm(os_timer_boot_us + at);
+    }
+    else
+    {
+        nos_vtime_disarm();
+    }
+#else
+    struct itimerval it = { { 0, 0 }, { 0, 0 } };
+    uint64_t now = os_timer_time_us();
+    uint64_t us = (at > now) ? at - now : 1;
+
+    if (arm)
+    {
+        it.it_value.tv_sec = us / 1000000;
+        it.it_value.tv_usec = us % 1000000;
+    }
+
+    os_timer_tick_clear_pending();
+    setitimer(ITIMER_REAL, &it, NULL);
+#endif
+}
+
+static void os_timer_host_update(void)
+{
+#ifndef SCHED_TICKLESS
+    uint64_t next = (os_timer_time_us() / OS_TIMER_TICK_US + 1) * OS_TIMER_TICK_US;
+
+#ifdef SIM_VIRTUAL_TIME
+    // the simulation still ends when no timer is pending
+    os_timer_host_arm(os_timer_armed, next);
+#else
+    os_timer_host_arm(TRUE, next);
+#endif
+#else
+    os_timer_host_arm(os_timer_armed, os_timer_deadline_us);
+#endif
+}
+
+// Raises the tick interrupt @tick ticks after the current one (0: immediately).
+void os_timer_tick_set(UINT32 tick)
+{
+    uint64_t now = os_timer_time_us();
+
+    os_timer_deadline_us = (now / OS_TIMER_TICK_US + tick) * OS_TIMER_TICK_US;
+    if (os_timer_deadline_us < now)
+    {
+        os_timer_deadline_us = now;
+    }
+    os_timer_armed = TRUE;
+
+#ifndef SCHED_TICKLESS
+    if (!tick)
+    {
+        os_timer_host_arm(TRUE, now);
+        return;
+    }
+#endif
+    os_timer_host_update();
+}
+
+void os_timer_tick_stop(void)
+{
+    os_timer_armed = FALSE;
+    os_timer_host_update();
+}
+
+// Returns TRUE when the tick signal reached the programmed tick.
+BOOL os_timer_tick_isr(void)
+{
+    if (os_timer_armed && os_timer_time_us() >= os_timer_deadline_us)
+    {
+        os_timer_armed = FALSE;
+#ifndef SCHED_TICKLESS
+        os_timer_host_update();
+#endif
+        return TRUE;
+    }
+
+    os_timer_host_update();
+    return FALSE;
+}
+
+// Adds @tick ticks spent with the tick timer stopped; the host clock never stops.
+void os_timer_tick_credit(UINT32 tick)
+{
+    (void)tick;
+}
+
+// Microseconds since boot, monotonic.
+UINT64 os_timer_time_us(void)
+{
+    return nos_timer_host_us() - os_timer_boot_us;
+}
+
+
+/* Timer for measuring elaspsed time in code (1ms unit) */
+
+void init_MT(void)
+{
+    MT_Reset();
+    MT_running = FALSE;
+}
+
+void start_MT(void)
+{
+    MT_start_us = nos_timer_host_us();
+    MT_running = TRUE;
+}
+
+uint32_t MT_get_time(void)
+{
+    uint64_t us = MT_elapsed_us;
+
+    if (MT_running)
+    {
+        us += nos_timer_host_us() - MT_start_us;
+    }
+    MeasureTimer_CNT = (uint32_t)(us / 1000);
+    return MeasureTimer_CNT; // 1ms
+}
+
+void MT_stop(void)
+{
+    if (MT_running)
+    {
+        MT_elapsed_us += nos_timer_host_us() - MT_start_us;
+        MT_running = FALSE;
+    }
+}
+
+void MT_Restart(void)
+{
+    if (!MT_running)
+    {
+        start_MT();
+    }
+}
+
+void MT_Reset(void)
+{
+    MT_elapsed_us = 0;
+    MeasureTimer_CNT = 0;
+    start_MT();
+}
+
+uint32_t get_SysTick_time(void)
+{
+    return (uint32_t)(os_timer_time_us() / 1000);
+}
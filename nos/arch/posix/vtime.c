@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2015  Electronics and Telecommunications Research Institute (ETRI)
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file vtime.c
+ * @brief Virtual time for the POSIX host port (discrete-event simulation)
+ */
+
+#include "kconf.h"
+
+#ifdef SIM_VIRTUAL_TIME
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "vtime.h"
+#include "critical_section.h"
+#include "hal_sched.h"
+#include "tick.h"
+#include "sched.h"
+
+#ifndef CONFIG_SIM_VIRTUAL_TIME_LIMIT
+#define CONFIG_SIM_VIRTUAL_TIME_LIMIT	0	// seconds, 0 means no limit
+#endif
+
+extern THREAD *highest_thread;
+
+static uint64_t nos_vtime_us;
+static uint64_t nos_vtime_deadline_us;
+static bool nos_vtime_armed;
+
+static NOS_VTIME_STATS nos_vtime_stats = { .handler_ns_min = 0xFFFFFFFF };
+
+
+static uint64_t nos_vtime_host_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/*
+ * The tick interrupt, taken at the current virtual time. Same sequence as
+ * the signal entry nos_hal_tick_entry(), with the interrupt mask saved and
+ * restored around it like PRIMASK around an exception.
+ */
+static void nos_vtime_raise(void)
+{
+	bool masked = nos_hal_irq_masked;
+	uint64_t t0, ns;
+	UINT32 depth;
+
+	nos_vtime_armed = FALSE;
+	nos_hal_irq_masked = TRUE;
+
+	depth = tickq_Count();
+	nos_vtime_stats.wakeups++;
+	nos_vtime_stats.tickq_depth_sum += depth;
+	if (depth > nos_vtime_stats.tickq_depth_max)
+	{
+		nos_vtime_stats.tickq_depth_max = depth;
+	}
+
+	++nested_intr_cnt;
+	t0 = nos_vtime_host_ns();
+	SysTick_Handler();
+	ns = nos_vtime_host_ns() - t0;
+	--nested_intr_cnt;
+
+	nos_vtime_stats.handler_ns_sum += ns;
+	if (ns > nos_vtime_stats.handler_ns_max)
+	{
+		nos_vtime_stats.handler_ns_max = (UINT32)ns;
+	}
+	if (ns < nos_vtime_stats.handler_ns_min)
+	{
+		nos_vtime_stats.handler_ns_min = (UINT32)ns;
+	}
+
+	if (nos_hal_pendsv)
+	{
+		if (highest_thread != current_thread)
+		{
+			nos_vtime_stats.ctx_switches++;
+		}
+		PendSV_Handler();	// returns when this thread is resumed
+	}
+
+	nos_hal_irq_masked = masked;
+}
+
+static void nos_vtime_finish(const char *reason)
+{
+	printf("\n## Virtual time simulation ends: %s\n", reason);
+	nos_vtime_report();
+	exit(0);
+}
+
+uint64_t nos_vtime_now_us(void)
+{
+	return nos_vtime_us;
+}
+
+void nos_vtime_arm(uint64_t deadline_us)
+{
+	nos_vtime_deadline_us = deadline_us;
+	nos_vtime_armed = TRUE;
+}
+
+void nos_vtime_disarm(void)
+{
+	nos_vtime_armed = FALSE;
+}
+
+void nos_vtime_advance(uint64_t us)
+{
+	// Ticks falling inside the busy period are taken on time unless masked.
+	// The time spent in the handler and in the threads it switches to does
+	// not count as work of this thread: the rest of the work is done after.
+	while (nos_vtime_armed && nos_vtime_deadline_us <= nos_vtime_us + us &&
+	       !nos_hal_irq_masked && nested_intr_cnt == 0)
+	{
+		if (nos_vtime_deadline_us > nos_vtime_us)
+		{
+			us -= nos_vtime_deadline_us - nos_vtime_us;
+			nos_vtime_us = nos_vtime_deadline_us;
+		}
+		nos_vtime_raise();
+	}
+
+	nos_vtime_us += us;
+}
+
+void nos_vtime_idle(void)
+{
+	uint64_t limit_us = (uint64_t)CONFIG_SIM_VIRTUAL_TIME_LIMIT * 1000000;
+
+	if (!nos_vtime_armed)
+	{
+		nos_vtime_finish("all threads blocked, no timer pending");
+	}
+
+	if (limit_us && nos_vtime_deadline_us > limit_us)
+	{
+		if (limit_us > nos_vtime_us)
+		{
+			nos_vtime_stats.idle_us += limit_us - nos_vtime_us;
+			nos_vtime_us = limit_us;
+		}
+		nos_vtime_finish("time limit reached");
+	}
+
+	if (nos_vtime_deadline_us > nos_vtime_us)
+	{
+		nos_vtime_stats.idle_jumps++;
+		nos_vtime_stats.idle_us += nos_vtime_deadline_us - nos_vtime_us;
+		nos_vtime_us = nos_vtime_deadline_us;
+	}
+
+	// WFI wakes up even with interrupts disabled, like sigsuspend() does.
+	nos_vtime_raise();
+}
+
+void nos_vtime_poll(void)
+{
+	while (nos_vtime_armed && nos_vtime_deadline_us <= nos_vtime_us &&
+	       !nos_hal_irq_masked && nested_intr_cnt == 0)
+	{
+		nos_vtime_raise();
+	}
+}
+
+void nos_vtime_idle_mode(UINT32 mode)
+{
+	if (mode < NOS_VTIME_IDLE_MODES)
+	{
+		nos_vtime_stats.idle_modes[mode]++;
+	}
+}
+
+void nos_vtime_get_stats(NOS_VTIME_STATS *stats)
+{
+	*stats = nos_vtime_stats;
+	stats->now_us = nos_vtime_us;
+}
+
+void nos_vtime_reset_stats(void)
+{
+	UINT32 i;
+
+	nos_vtime_stats.idle_us = 0;
+	nos_vtime_stats.idle_jumps = 0;
+	for (i = 0; i < NOS_VTIME_IDLE_MODES; i++)
+	{
+		nos_vtime_stats.idle_modes[i] = 0;
+	}
+	nos_vtime_stats.wakeups = 0;
+	nos_vtime_stats.ctx_switches = 0;
+	nos_vtime_stats.tickq_depth_max = 0;
+	nos_vtime_stats.tickq_depth_sum = 0;
+	nos_vtime_stats.handler_ns_min = 0xFFFFFFFF;
+	nos_vtime_stats.handler_ns_max = 0;
+	nos_vtime_stats.handler_ns_sum = 0;
+}
+
+void nos_vtime_report(void)
+{
+	NOS_VTIME_STATS s;
+	UINT32 n;
+
+	nos_vtime_get_stats(&s);
+	n = s.wakeups ? s.wakeups : 1;
+
+	printf("   virtual time   : %llu.%06llu s (idle %llu.%06llu s, %u jumps)\n",
+	       (unsigned long long)(s.now_us / 1000000), (unsigned long long)(s.now_us % 1000000),
+	       (unsigned long long)(s.idle_us / 1000000), (unsigned long long)(s.idle_us % 1000000),
+	       (unsigned)s.idle_jumps);
+	printf("   idle modes     : idle %u, sleep %u, stop %u, standby %u, poweroff %u\n",
+	       (unsigned)s.idle_modes[0], (unsigned)s.idle_modes[1], (unsigned)s.idle_modes[2],
+	       (unsigned)s.idle_modes[3], (unsigned)s.idle_modes[4]);
+	printf("   tick wakeups   : %u (%u preempting)\n",
+	       (unsigned)s.wakeups, (unsigned)s.ctx_switches);
+	printf("   tick_q depth   : avg %llu.%02llu, max %u\n",
+	       (unsigned long long)(s.tickq_depth_sum / n),
+	       (unsigned long long)(s.tickq_depth_sum * 100 / n % 100),
+	       (unsigned)s.tickq_depth_max);
+	printf("   handler (host) : avg %llu ns, min %u ns, max %u ns\n",
+	       (unsigned long long)(s.handler_ns_sum / n),
+	       (unsigned)(s.wakeups ? s.handler_ns_min : 0), (unsigned)s.handler_ns_max);
+}
+
+#endif // SIM_VIRTUAL_TIME
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2015  Electronics and Telecommunications Research Institute (ETRI)
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file vtime.h
+ * @brief Virtual time for the POSIX host port (discrete-event simulation)
+ *
+ * With SIM_VIRTUAL_TIME the tick source is not SIGALRM but a virtual clock.
+ * The clock only moves when the simulated CPU has nothing to do: when the idle
+ * thread waits for an interrupt, time jumps straight to the deadline that
+ * os_timer_tick_set() programmed for the next tick_q expiry, and the tick handler
+ * is raised synchronously. nos_delay_us() is the only way for a thread to
+ * consume virtual time while running. Runs are therefore deterministic and
+ * as fast as the host can execute the handlers.
+ *
+ * The simulation ends when every thread is blocked and no timer is pending,
+ * or when CONFIG_SIM_VIRTUAL_TIME_LIMIT seconds have been simulated. The
+ * statistics are then printed and the process exits.
+ */
+
+#ifndef __VTIME_H__
+#define __VTIME_H__
+
+#include "kconf.h"
+
+#ifdef SIM_VIRTUAL_TIME
+
+#include "nos_common.h"
+
+#define NOS_VTIME_IDLE_MODES	5	// IDLE_MODE ... POWEROFF_MODE (lowpower.h)
+
+typedef struct _nos_vtime_stats
+{
+	uint64_t now_us;		// current virtual time
+	uint64_t idle_us;		// virtual time skipped while every thread was blocked
+	UINT32 idle_jumps;		// number of fast-forwards
+	UINT32 idle_modes[NOS_VTIME_IDLE_MODES];	// idle periods per low power mode
+
+	UINT32 wakeups;			// tick interrupts raised
+	UINT32 ctx_switches;		// ... that preempted the running thread
+
+	UINT32 tickq_depth_max;		// tick_q length seen by the tick handler
+	uint64_t tickq_depth_sum;
+
+	UINT32 handler_ns_min;		// host time spent in SysTick_Handler()
+	UINT32 handler_ns_max;
+	uint64_t handler_ns_sum;
+} NOS_VTIME_STATS;
+
+/// Current virtual time in microseconds.
+uint64_t nos_vtime_now_us(void);
+
+/// Program (or cancel) the virtual tick deadline.
+void nos_vtime_arm(uint64_t deadline_us);
+void nos_vtime_disarm(void);
+
+/// Consume @p us of virtual time on the running thread (busy wait).
+void nos_vtime_advance(uint64_t us);
+
+/// Idle: jump to the tick deadline and raise the tick (WFI).
+void nos_vtime_idle(void);
+
+/// Raise a tick that became due while interrupts were disabled.
+void nos_vtime_poll(void);
+
+/// Account an idle period for low power mode @p mode.
+void nos_vtime_idle_mode(UINT32 mode);
+
+void nos_vtime_get_stats(NOS_VTIME_STATS *stats);
+void nos_vtime_reset_stats(void);
+void nos_vtime_report(void);
+
+#endif // SIM_VIRTUAL_TIME
+#endif // __VTIME_H__
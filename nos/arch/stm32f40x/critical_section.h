@@ -64,7 +64,11 @@ do { \
 		NOS_ENABLE_GLOBAL_INTERRUPT(); \
 } while (0)
 
-	/*
+/*
+ * Every handler that can reach the kernel is bracketed by OS_ENTER_ISR() and
+ * OS_EXIT_ISR(). IPSR cannot tell ISR mode: PendSV switches context in
+ * Handler mode, so threads run with the PendSV exception number active.
+ */
 #define OS_ENTER_ISR()	\
 do { \
 	++nested_intr_cnt; \
@@ -74,7 +78,7 @@ do { \
 do { \
 	--nested_intr_cnt; \
 } while (0)
-*/
+
 /*
 #define OS_IS_CTX_SW_ALLOWABLE() ((!nested_intr_cnt)&&(!intr_status.cnt))
 */
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2015  Electronics and Telecommunications Research Institute (ETRI)
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file hal_atomic.h
+ * @brief Lock-free atomic operations for Cortex-M4 (LDREX/STREX, DMB)
+ *
+ * None of them masks interrupts. An exception taken between LDREX and STREX
+ * clears the exclusive monitor, so the STREX fails and the loop retries.
+ */
+
+#ifndef HAL_ATOMIC_H
+#define HAL_ATOMIC_H
+
+#include "stm32f4xx.h"
+#include "nos_common.h"
+
+typedef volatile UINT32 NOS_ATOMIC_U32;
+
+static inline UINT32 nos_atomic_load(NOS_ATOMIC_U32 *p)
+{
+	return *p;
+}
+
+/// Loads made after it are not performed before it.
+static inline UINT32 nos_atomic_load_acquire(NOS_ATOMIC_U32 *p)
+{
+	UINT32 v = *p;
+
+	__DMB();
+	return v;
+}
+
+/// Stores made before it are visible before it.
+static inline void nos_atomic_store_release(NOS_ATOMIC_U32 *p, UINT32 v)
+{
+	__DMB();
+	*p = v;
+}
+
+/// Sets *p to desired if it holds expected. Returns TRUE on success.
+static inline BOOL nos_atomic_cas(NOS_ATOMIC_U32 *p, UINT32 expected, UINT32 desired)
+{
+	do
+	{
+		if (__LDREXW(p) != expected)
+		{
+			__CLREX();
+			return FALSE;
+		}
+	} while (__STREXW(desired, p));
+
+	__DMB();
+	return TRUE;
+}
+
+/// Adds v to *p and returns the new value.
+static inline UINT32 nos_atomic_add(NOS_ATOMIC_U32 *p, UINT32 v)
+{
+	UINT32 n;
+
+	do
+	{
+		n = __LDREXW(p) + v;
+	} while (__STREXW(n, p));
+
+	__DMB();
+	return n;
+}
+
+#endif // HAL_ATOMIC_H
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2015  Electronics and Telecommunications Research Institute (ETRI)
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file hal_hrtimer.c
+ * @brief Compare timer of the high-resolution timers (TIM2, 32-bit, 1MHz)
+ */
+
+#include "kconf.h"
+
+#ifdef HRTIMER_M
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_tim.h"
+#include "misc.h"
+#include "platform.h"
+#include "hal_hrtimer.h"
+
+/* APB1 is divided by 4, so the APB1 timers run at twice PCLK1 */
+#define HRTIMER_TIM_CLK		(PCLK1 * 2)
+
+void nos_hrtimer_hal_init(void)
+{
+	NVIC_InitTypeDef NVIC_InitStructure;
+	TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+	TIM_OCInitTypeDef TIM_OCInitStructure;
+
+	RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+	TIM_DeInit(TIM2);
+
+	TIM_TimeBaseStructure.TIM_Prescaler = HRTIMER_TIM_CLK / 1000000 - 1;	// 1us
+	TIM_TimeBaseStructure.TIM_Period = 0xFFFFFFFF;
+	TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+	TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+	TIM_TimeBaseStructure.TIM_RepetitionCounter = 0;
+	TIM_TimeBaseInit(TIM2, &TIM_TimeBaseStructure);
+
+	/* channel 1 only compares, no output */
+	TIM_OCStructInit(&TIM_OCInitStructure);
+	TIM_OCInitStructure.TIM_OCMode = TIM_OCMode_Timing;
+	TIM_OC1Init(TIM2, &TIM_OCInitStructure);
+	TIM_OC1PreloadConfig(TIM2, TIM_OCPreload_Disable);
+
+	TIM_ClearITPendingBit(TIM2, TIM_IT_CC1);
+
+	NVIC_InitStructure.NVIC_IRQChannel = TIM2_IRQn;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 1;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init(&NVIC_InitStructure);
+
+	TIM2->CNT = 0;
+	TIM_Cmd(TIM2, ENABLE);
+}
+
+UINT32 nos_hrtimer_hal_now(void)
+{
+	return TIM2->CNT;
+}
+
+void nos_hrtimer_hal_set(UINT32 when)
+{
+	TIM_SetCompare1(TIM2, when);
+	TIM_ClearITPendingBit(TIM2, TIM_IT_CC1);
+	TIM_ITConfig(TIM2, TIM_IT_CC1, ENABLE);
+
+	/* the match is missed if the counter has passed it already */
+	if ((INT32)(when - TIM2->CNT) <= 0)
+	{
+		TIM_GenerateEvent(TIM2, TIM_EventSource_CC1);
+	}
+}
+
+void nos_hrtimer_hal_stop(void)
+{
+	TIM_ITConfig(TIM2, TIM_IT_CC1, DISABLE);
+	TIM_ClearITPendingBit(TIM2, TIM_IT_CC1);
+}
+
+#endif // HRTIMER_M
@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2015  Electronics and Telecommunications Research Institute (ETRI)
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file hal_hrtimer.h
+ * @brief Compare timer of the high-resolution timers (TIM2, 32-bit, 1MHz)
+ *
+ * TIM2 counts up at 1MHz over the whole 32-bit range; compare channel 1
+ * interrupts at the earliest deadline. With HRTIMER_M, TIM2 is not available
+ * as nos_timer channel 1: nos_timer_config() and nos_timer_start() refuse it
+ * with EXIT_RESOURCE_BUSY and nos_timer_release() leaves it running.
+ */
+
+#ifndef HAL_HRTIMER_H
+#define HAL_HRTIMER_H
+
+#include "kconf.h"
+#include "nos_common.h"
+
+void nos_hrtimer_hal_init(void);
+
+/// Current counter value (us).
+UINT32 nos_hrtimer_hal_now(void);
+
+/// Interrupt at @p when, or right away if @p when has passed.
+void nos_hrtimer_hal_set(UINT32 when);
+void nos_hrtimer_hal_stop(void);
+
+#endif // HAL_HRTIMER_H
@@ -65,6 +65,9 @@
 #error "Unknown scheduling time slice"
 #endif
 
+// Count leading zeros, used by the ready queue and tick_q.
+#define NOS_CLZ(x)              __CLZ(x)
+
 #define KERNEL_DEFERRED_CTX_SW 1
 #define NOS_CTX_SW_PENDING_SET() \
     do { SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk; } while (0)
@@ -48,7 +48,222 @@
 #include "heap.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include "arch.h"
 #include "critical_section.h"
+#ifdef HEAP_REGIONS
+#include "stm32f4xx_conf.h"
+#endif
+
+#ifdef HEAP_TLSF
+/*
+ * TLSF over the _sbrk heap (from _end up to the kernel stack). Consecutive
+ * _sbrk areas join the previous pool. The critical section only covers the
+ * allocator, which runs in bounded time.
+ */
+#ifndef CONFIG_HEAP_TLSF_GROW
+#define CONFIG_HEAP_TLSF_GROW   4096
+#endif
+
+extern caddr_t _sbrk(int incr);
+
+static TLSF os_heap;    /* zeroed: empty */
+
+#ifdef HEAP_REGIONS
+/*
+ * CCM and backup SRAM heaps over what the linker script leaves free of the
+ * two RAMs (_sccmheap.._eccmheap, _sbkpheap.._ebkpheap). Of the backup SRAM
+ * only the top CONFIG_HEAP_BKPSRAM_SIZE bytes are taken: the rest is left
+ * to the fixed addresses bkpsram_write() and nos_store_context use. The
+ * heaps are rebuilt at every boot, so blocks do not outlive a reset.
+ */
+#ifndef CONFIG_HEAP_BKPSRAM_SIZE
+#define CONFIG_HEAP_BKPSRAM_SIZE    1024
+#endif
+
+extern UINT8 _sccmheap[], _eccmheap[], _sbkpheap[], _ebkpheap[];
+
+static TLSF os_heap_ccm, os_heap_bkpsram;
+
+/* the heap of a region, set up on first use; NULL if there is none */
+static TLSF *os_heap_region(UINT32 region)
+{
+    static BOOL ready;
+    UINT8 *bkp;
+
+    if (!ready)
+    {
+        tlsf_add_pool(&os_heap_ccm, _sccmheap, _eccmheap - _sccmheap);
+
+        /* the backup SRAM needs its clock and write access */
+        RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_BKPSRAM, ENABLE);
+        RCC_APB1PeriphClockCmd(RCC_APB1Periph_PWR, ENABLE);
+        PWR_BackupAccessCmd(ENABLE);
+        bkp = _ebkpheap - CONFIG_HEAP_BKPSRAM_SIZE;
+        if (bkp < _sbkpheap)
+        {
+            bkp = _sbkpheap;
+        }
+        tlsf_add_pool(&os_heap_bkpsram, bkp, _ebkpheap - bkp);
+        ready = TRUE;
+    }
+
+    switch (region)
+    {
+    case MEM_SRAM:
+        return &os_heap;
+    case MEM_CCM:
+        return &os_heap_ccm;
+    case MEM_BKPSRAM:
+        return &os_heap_bkpsram;
+    }
+    return NULL;
+}
+
+/* the heap of a block, by its address */
+static TLSF *os_heap_of(void *ptr)
+{
+    UINT8 *p = ptr;
+
+    if ((p >= _sccmheap) && (p < _eccmheap))
+    {
+        return &os_heap_ccm;
+    }
+    if ((p >= _sbkpheap) && (p < _ebkpheap))
+    {
+        return &os_heap_bkpsram;
+    }
+    return &os_heap;
+}
+#else
+#define os_heap_of(ptr)         (&os_heap)
+#endif
+
+static BOOL os_heap_grow(UINT32 len)
+{
+    UINT32 bytes = tlsf_pool_size(len);
+    caddr_t mem;
+
+    if (bytes == 0)
+    {
+        return FALSE;
+    }
+    if (bytes < CONFIG_HEAP_TLSF_GROW)
+    {
+        bytes = CONFIG_HEAP_TLSF_GROW;
+    }
+    bytes = (bytes + TLSF_ALIGN - 1) & ~(TLSF_ALIGN - 1);
+
+    mem = _sbrk(bytes);
+    if (mem == (caddr_t)-1)
+    {
+        return FALSE;
+    }
+    return tlsf_add_pool(&os_heap, mem, bytes);
+}
+
+/* only the main heap grows */
+static void *os_heap_malloc(TLSF *heap, UINT32 len)
+{
+    void *ptr = tlsf_malloc(heap, len);
+
+    if ((ptr == NULL) && (heap == &os_heap) && os_heap_grow(len))
+    {
+        ptr = tlsf_malloc(heap, len);
+    }
+    return ptr;
+}
+
+void *nos_malloc(UINT32 len)
+{
+    void *ptr;
+
+    NOS_ENTER_CRITICAL_SECTION();
+    ptr = os_heap_malloc(&os_heap, len);
+#ifdef HEAP_PROFILE
+    os_heap_profile_alloc(ptr, len, __builtin_return_address(0));
+#endif
+#ifdef HEAP_DEBUG
+    printf("%s()-len:%u, ptr:0x%p\n\r", __FUNCTION__, len, ptr);
+#endif
+    NOS_EXIT_CRITICAL_SECTION();
+
+    return ptr;
+}
+
+void nos_free(void *ptr)
+{
+    BOOL ok;
+
+    NOS_ENTER_CRITICAL_SECTION();
+#ifdef HEAP_DEBUG
+    printf("%s()-ptr:0x%p\n\r", __FUNCTION__, ptr);
+#endif
+    ok = tlsf_free(os_heap_of(ptr), ptr);
+#ifdef HEAP_PROFILE
+    if (ok)
+    {
+        os_heap_profile_free(ptr);
+    }
+#endif
+    NOS_EXIT_CRITICAL_SECTION();
+
+    if (!ok)
+    {
+        printf("nos_free(0x%p): bad block\n\r", ptr);
+        system_abort(0);
+    }
+}
+
+void nos_heap_get_stats(TLSF_STATS *stats)
+{
+    NOS_ENTER_CRITICAL_SECTION();
+    tlsf_get_stats(&os_heap, stats);
+    NOS_EXIT_CRITICAL_SECTION();
+}
+
+#ifdef HEAP_REGIONS
+/* NULL when the region is full: the caller decides about another one */
+void *nos_malloc_region(UINT32 region, UINT32 len)
+{
+    TLSF *heap;
+    void *ptr = NULL;
+
+    NOS_ENTER_CRITICAL_SECTION();
+    if ((heap = os_heap_region(region)) != NULL)
+    {
+        ptr = os_heap_malloc(heap, len);
+    }
+#ifdef HEAP_PROFILE
+    os_heap_profile_alloc(ptr, len, __builtin_return_address(0));
+#endif
+#ifdef HEAP_DEBUG
+    printf("%s()-region:%u, len:%u, ptr:0x%p\n\r", __FUNCTION__, region, len, ptr);
+#endif
+    NOS_EXIT_CRITICAL_SECTION();
+
+    return ptr;
+}
+
+void nos_heap_get_region_stats(UINT32 region, TLSF_STATS *stats)
+{
+    TLSF *heap;
+
+    NOS_ENTER_CRITICAL_SECTION();
+    if ((heap = os_heap_region(region)) != NULL)
+    {
+        tlsf_get_stats(heap, stats);
+    }
+    else
+    {
+        memset(stats, 0, sizeof(TLSF_STATS));
+    }
+    NOS_EXIT_CRITICAL_SECTION();
+}
+#endif
+
+#else
 
 void *nos_malloc(UINT32 len)
 {
@@ -75,3 +290,5 @@ void nos_free(void *ptr)
     free(ptr);
     NOS_EXIT_CRITICAL_SECTION();
 }
+
+#endif // HEAP_TLSF
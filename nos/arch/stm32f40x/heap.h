@@ -46,9 +46,42 @@
 #ifndef HEAP_H
 #define HEAP_H
 
+#include "kconf.h"
 #include "nos_common.h"
 
 void *nos_malloc(UINT32 len);
 void nos_free(void *ptr);
 
+#ifdef HEAP_TLSF
+#include "tlsf.h"
+
+void nos_heap_get_stats(TLSF_STATS *stats);
+#endif
+
+#ifdef HEAP_REGIONS
+/*
+ * Memory regions of nos_malloc_region(). MEM_CCM is the 64 KB core-coupled
+ * RAM: no wait state and no DMA traffic, but not reachable by DMA either.
+ * MEM_BKPSRAM is the top CONFIG_HEAP_BKPSRAM_SIZE bytes of the 4 KB backup
+ * SRAM. nos_free() takes a block of any region.
+ */
+enum
+{
+    MEM_SRAM,
+    MEM_CCM,
+    MEM_BKPSRAM,
+    MEM_REGIONS
+};
+
+void *nos_malloc_region(UINT32 region, UINT32 len);
+void nos_heap_get_region_stats(UINT32 region, TLSF_STATS *stats);
+#endif
+
+/* places a variable in CCM (.ccmram, not zeroed at startup) */
+#define MEM_CCM_ATTR    __attribute__((section(".ccmram")))
+
+#ifdef HEAP_PROFILE
+#include "heap_profile.h"
+#endif
+
 #endif /* HEAP_H */
@@ -55,12 +55,8 @@
 
 extern __IO uint32_t MeasureTimer_CNT;
 extern __IO uint32_t SysTick_CNT;
-extern DQUEUE tick_q;
 
 uint32_t nos_hal_timer_range_us[NOS_TIMER_NUM];
-UINT32 Tick_Period;
-UINT32 Remain_Tick_Value;
-UINT32 SysTick_Reload_OverFlow = 0;
 
 UINT32 __gcounter;
 UINT32 __saved_alid;
@@ -120,6 +116,14 @@ int nos_timer_config(int timer_channel, uint32_t us) {
 		return EXIT_FAIL;       
 	} // end if
 
+#ifdef HRTIMER_M
+	// TIM2 is the compare timer of the high-resolution timers (hal_hrtimer.h)
+	if (timer_channel == 1) {
+		NOS_DEBUG_ERROR;
+		return EXIT_RESOURCE_BUSY;
+	} // end if
+#endif
+
 	// Check whether timer is being used or not    
 	if (nos_timer_is_set(timer_channel) == TRUE) {
 		NOS_DEBUG_ERROR;
@@ -212,6 +216,14 @@ int nos_timer_start(int timer_channel) {
 
 	NOS_DEBUG_START;
 
+#ifdef HRTIMER_M
+	// TIM2 is the compare timer of the high-resolution timers (hal_hrtimer.h)
+	if (timer_channel == 1) {
+		NOS_DEBUG_ERROR;
+		return EXIT_RESOURCE_BUSY;
+	} // end if
+#endif
+
 	// Starts timer ASAP (check error later.)
 	switch (timer_channel) {
 		case 0: //HW timer1
@@ -336,6 +348,14 @@ uint32_t nos_timer_get_time(int timer_channel) {
 void nos_timer_release(int timer_channel) {
 
 	NOS_DEBUG_START;
+
+#ifdef HRTIMER_M
+	if (timer_channel == 1) {
+		NOS_DEBUG_ERROR;
+		return;
+	} // end if
+#endif
+
 	switch (timer_channel) {
 		case 0: //HW timer1
 			NOS_DEBUG_NOTIFY;
@@ -364,66 +384,139 @@ void nos_timer_release(int timer_channel) {
 	NOS_DEBUG_END;
 } // end func
 
-//Inserted by phj. @160302
-// Only use  32bit counter timer.
+/*
+ * Scheduler tick (SysTick)
+ *
+ * SysTick is a 24-bit down counter, about 100msec at SYSCLK. The cycles of
+ * every period are added to os_timer_cycles, which is the time base of the
+ * kernel: os_timer_time_us() reads it from threads and ISRs. A tick deadline
+ * is a cycle count on the grid of the tick period, so reprogramming the timer
+ * never shifts the ticks. A deadline farther than one SysTick period takes
+ * several periods; the periods in between only update the time base
+ * (os_timer_tick_isr() returns FALSE).
+ *
+ * The period is one tick and the deadline is only compared. With
+ * SCHED_TICKLESS the period runs to the deadline instead; without a deadline
+ * SysTick keeps running with the longest period, because the time base must
+ * see every wrap.
+ */
+#define OS_TIMER_TICK_CYCLES	(TICK_UNIT * SCHED_TIMER_MS * SYSTICK_CALIBRATION_SCALE)
+#define OS_TIMER_CYCLES_PER_US	(SYSCLK / 1000000)
 
-void os_timer_tick_set(UINT32 tick) {
+static UINT64 os_timer_cycles;		// cycles up to the start of the current period
+static UINT64 os_timer_deadline;	// cycle count of the programmed tick
+static BOOL os_timer_armed;
 
-	UINT32 SysTickCTRL;
-	//uart_printf("os_timer_tick_set :: tick is %d\r\n", tick);
-	//UINT32 Reload_Value = 0;
+// cycles since boot; call with interrupts disabled
+static UINT64 os_timer_cycles_now(void)
+{
+	UINT32 load = SysTick->LOAD;
+	UINT32 val = SysTick->VAL;
+	UINT64 cycles = os_timer_cycles;
+
+	// wrapped, but the SysTick interrupt is not taken yet
+	if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+		val = SysTick->VAL;
+		cycles += load + 1;
+	} // end if
 
-	//DNODE *dnode = tick_q.head;
+	return cycles + (load - val);
+} // end func
 
-	if (!tick) {
-		// if tick is 0, systick_handler calls immediately.
-		//SysTick->LOAD = 10 * SYSTICK_CALIBRATION_SCALE;
-		SysTick->LOAD = 1;
-		SysTick->VAL = 0;
-		SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
-		return;
-	} // end if
+// restart SysTick with a period of @cycles (at most MAX_SYSTICK_VALUE + 1)
+static void os_timer_reload(UINT32 cycles)
+{
+	os_timer_cycles = os_timer_cycles_now();
+	SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
 
-	tick = tick * 10 * SYSTICK_CALIBRATION_SCALE;
+	SysTick->LOAD = cycles - 1;
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+} // end func
 
-	// backup & disable systick
-	SysTickCTRL = SysTick->CTRL;
-	SysTick->CTRL = SysTickCTRL & ~SysTick_CTRL_ENABLE_Msk;
+#ifdef SCHED_TICKLESS
+// the next SysTick period towards the deadline
+static void os_timer_reload_next(void)
+{
+	UINT64 now = os_timer_cycles_now();
+	UINT64 left;
 
-	// normaly, enable tick and set up tick
-	if ((tick > 0) && (tick < MAX_SUPPRESSTICK)) {
-		SysTick->LOAD = tick * TICK_UNIT;
-		SysTick->VAL = 0;
-		SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
-		return;
+	if (!os_timer_armed) {
+		left = MAX_SYSTICK_VALUE + 1;
+	} else if (os_timer_deadline < now + 2) {
+		left = 2;	// shortest period that raises the interrupt
+	} else {
+		left = os_timer_deadline - now;
+		if (left > MAX_SYSTICK_VALUE + 1) {
+			left = MAX_SYSTICK_VALUE + 1;
+		} // end if
 	} // end if
 
-	// when systick has overflow, uses SysTick_CNT
-	if (SysTick_Reload_OverFlow == 0) {
-		SysTick_Reload_OverFlow = 1;
-		Tick_Period = tick / MAX_SUPPRESSTICK; // tick / 99msec
-		Remain_Tick_Value = ((tick % MAX_SUPPRESSTICK) / 10) * 10; // more than 10msec
-		Tick_Period--;
+	os_timer_reload((UINT32)left);
+} // end func
+#endif
+
+// Raises the tick interrupt @tick ticks after the current one (0: immediately).
+void os_timer_tick_set(UINT32 tick) {
+	UINT32 primask = __get_PRIMASK();
+	UINT64 now;
+
+	__disable_irq();
+
+	now = os_timer_cycles_now();
+	os_timer_deadline = (now / OS_TIMER_TICK_CYCLES + tick) * OS_TIMER_TICK_CYCLES;
+	if (os_timer_deadline <= now) {
+		os_timer_deadline = now + 1;
 	} // end if
+	os_timer_armed = TRUE;
 
-	SysTick_CNT++;
+#ifdef SCHED_TICKLESS
+	os_timer_reload_next();
+#endif
 
-	SysTick->LOAD = MAX_SYSTICK_VALUE;
-	SysTick->VAL = 0;
-	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	__set_PRIMASK(primask);
 } // end func
 
 void os_timer_tick_stop(void) {
-	UINT32 SysTickCTRL;
+	os_timer_armed = FALSE;
+} // end func
+
+// Returns TRUE when the SysTick interrupt reached the programmed tick.
+BOOL os_timer_tick_isr(void) {
+	BOOL reached = FALSE;
+
+	os_timer_cycles += SysTick->LOAD + 1;	// the period just completed
+
+	if (os_timer_armed && (os_timer_cycles_now() >= os_timer_deadline)) {
+		os_timer_armed = FALSE;
+		reached = TRUE;
+	} // end if
+
+#ifdef SCHED_TICKLESS
+	os_timer_reload_next();
+#endif
+	return reached;
+} // end func
 
-	SysTickCTRL = SysTick->CTRL;
-	SysTick->CTRL = SysTickCTRL & ~SysTick_CTRL_ENABLE_Msk;
+// Adds @tick ticks spent with SysTick stopped (STOP mode, woken by the RTC).
+void os_timer_tick_credit(UINT32 tick) {
+	UINT32 primask = __get_PRIMASK();
 
+	__disable_irq();
+	os_timer_cycles += (UINT64)tick * OS_TIMER_TICK_CYCLES;
+	__set_PRIMASK(primask);
 } // end func
 
-// FIXME: os_timer_tick_get returns count of TIM2, not tick value. tick must be a unit of 10msec.
-UINT32 os_timer_tick_get(void) {
-	return SysTick->VAL;
+// Microseconds since boot, monotonic.
+UINT64 os_timer_time_us(void) {
+	UINT32 primask = __get_PRIMASK();
+	UINT64 now;
+
+	__disable_irq();
+	now = os_timer_cycles_now();
+	__set_PRIMASK(primask);
+
+	return now / OS_TIMER_CYCLES_PER_US;
 } // end func
 
 void nos_EnableTimerInt(int timer_channel)
@@ -524,7 +617,7 @@ void MT_Reset(void){
 
 uint32_t get_SysTick_time(void)
 {
-	return (SysTick_CNT*10); 
+	return (uint32_t)(os_timer_time_us() / 1000);
 }
 
 
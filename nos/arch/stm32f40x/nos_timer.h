@@ -76,7 +76,6 @@ NOS Timer Usage  (including CRITICAL_SECTION or ISR)
 //#define TICK_UNIT	420000		/* 10ms */
 
 // The units below are when systick is systimer
-#define MAX_SUPPRESSTICK		99
 #define MAX_SYSTICK_VALUE		0xFFFFFF
 //#define SYSTICK_CALIBRATION_SCALE	1.214
 #define SYSTICK_CALIBRATION_SCALE	1
@@ -94,7 +93,9 @@ void nos_timer_release(int timer_channel);
 //Inserted by phj. @160302
 void os_timer_tick_set(UINT32 tick);
 void os_timer_tick_stop(void);
-UINT32 os_timer_tick_get(void);
+BOOL os_timer_tick_isr(void);
+void os_timer_tick_credit(UINT32 tick);
+UINT64 os_timer_time_us(void);
 
 void init_MT(void);
 void start_MT(void);
@@ -10,23 +10,26 @@
 
 #include "sched.h"
 #include "heap.h"
+#include "mempool.h"
 #include "critical_section.h"
 #include "tick.h"
 #include "queue_delta.h"
+#include "queue_thread.h"
+#include "thread.h"
 #include "error.h"
 
 UINT32 task_wt; //task working time. @phj.
 //extern __IO uint32_t SysTick_CNT;
 extern __IO uint32_t TIM2_CNT;
-extern DQUEUE	tick_q;
-
-extern UINT32 SysTick_Reload_OverFlow;
-extern UINT32 Tick_Period;
-extern UINT32 Remain_Tick_Value;
 
 
 
 static void os_alarm_exe(UINT32 alid);
+
+#ifdef ALARM_THREAD
+static ALARM *os_alarm_head, *os_alarm_tail;	/* expired alarms, FIFO */
+static TQUEUE os_alarm_wait_q;			/* the timer thread while idle */
+#endif
 //modified by @phj. 20160621
 STATUS _alarm_spawn(void (*func)(UINT32), UINT32 arg, UINT32 increment, UINT32 cycle, UINT32 *alid,  UINT32 work)
 {
@@ -42,26 +45,64 @@ STATUS _alarm_spawn(void (*func)(UINT32), UINT32 arg, UINT32 increment, UINT32 c
 	return status;
 }
 
+static void os_alarm_setup(ALARM *alarm, void (*func)(UINT32), UINT32 arg, UINT32 increment, UINT32 cycle, UINT32 work, BOOL is_static)
+{
+	alarm->alid			= (UINT32) alarm;
+	alarm->increment	= increment;  
+	alarm->cycle 		= cycle;
+	alarm->work			= work; //2016.06.22 @phj.
+	alarm->slack		= 0;
+	alarm->handler		= func;
+	alarm->arg			= arg;
+	alarm->is_static	= is_static;
+#ifdef ALARM_THREAD
+	alarm->next_pending	= NULL;
+	alarm->pending		= FALSE;
+#endif
+
+	init_dnode(&alarm->alarm_dnode, os_alarm_exe, (UINT32)alarm);
+}
+
+#ifdef ALARM_THREAD
+/* takes an expired alarm off the FIFO before its handler runs (scheduler locked) */
+static void os_alarm_unpend(ALARM *alarm)
+{
+	ALARM *p, *prev = NULL;
+
+	if (alarm->pending)
+	{
+		for (p = os_alarm_head; p != alarm; prev = p, p = p->next_pending);
+		if (prev != NULL)
+		{
+			prev->next_pending = alarm->next_pending;
+		}
+		else
+		{
+			os_alarm_head = alarm->next_pending;
+		}
+		if (os_alarm_tail == alarm)
+		{
+			os_alarm_tail = prev;
+		}
+		alarm->next_pending = NULL;
+		alarm->pending = FALSE;
+	}
+}
+#endif
+
 //modified by @phj. 20160621
 STATUS _alarm_create(void (*func)(UINT32), UINT32 arg, UINT32 increment, UINT32 cycle, UINT32 *alid, UINT32 work)
 {
 	STATUS status = E_OK;
 	ALARM *alarm;
 
-	if ((alarm = nos_malloc(sizeof(struct _alarm))) == NULL)
+	if ((alarm = os_kobj_alloc(KOBJ_ALARM, sizeof(struct _alarm))) == NULL)
 	{
 		status = E_ALARM_ID;
 	}
 	else
 	{		
-		alarm->alid			= (UINT32) alarm;
-		alarm->increment	= increment;  
-		alarm->cycle 		= cycle;
-		alarm->work			= work; //2016.06.22 @phj.
-		alarm->handler		= func;
-		alarm->arg			= arg;
-
-		init_dnode(&alarm->alarm_dnode, os_alarm_exe, (UINT32)alarm);
+		os_alarm_setup(alarm, func, arg, increment, cycle, work, FALSE);
 
 		*alid = (UINT32)alarm;
 	}
@@ -71,6 +112,27 @@ STATUS _alarm_create(void (*func)(UINT32), UINT32 arg, UINT32 increment, UINT32
 	return status;
 }
 
+// Same as alarm_create(), in the caller's ALARM.
+STATUS _alarm_init(ALARM *alarm, void (*func)(UINT32), UINT32 arg, UINT32 increment, UINT32 cycle, UINT32 *alid, UINT32 work)
+{
+	STATUS status = E_OK;
+
+	if (alarm == NULL)
+	{
+		status = E_ALARM_INVALID;
+	}
+	else
+	{
+		os_alarm_setup(alarm, func, arg, increment, cycle, work, TRUE);
+
+		*alid = (UINT32)alarm;
+	}
+
+	service_error_check(S_ALARM_INIT, status);
+
+	return status;
+}
+
 STATUS alarm_destroy(UINT32 alid)
 {
 	STATUS status = E_OK;
@@ -83,8 +145,17 @@ STATUS alarm_destroy(UINT32 alid)
 	else 
 	{
 		os_sched_lock();
+
+		tickq_Remove(&alarm->alarm_dnode);
+
+#ifdef ALARM_THREAD
+		os_alarm_unpend(alarm);
+#endif
 		
-		nos_free(alarm);
+		if (!alarm->is_static)
+		{
+			os_kobj_free(KOBJ_ALARM, alarm);
+		}
 
 		os_sched_unlock();
 	}
@@ -107,6 +178,9 @@ STATUS alarm_start(UINT32 alid)
 	{
 		os_sched_lock();
 
+		/* the slack of a queued node must not change */
+		tickq_Remove(&alarm->alarm_dnode);
+		alarm->alarm_dnode.slack = alarm->slack;
 		tickq_Push(&alarm->alarm_dnode, alarm->increment);
 
 		os_sched_unlock();
@@ -131,6 +205,10 @@ STATUS alarm_stop(UINT32 alid)
 		os_sched_lock();
 
 		tickq_Remove(&alarm->alarm_dnode);
+#ifdef ALARM_THREAD
+		/* expired, its handler has not run yet: it will not */
+		os_alarm_unpend(alarm);
+#endif
 
 		os_sched_unlock();
 	}
@@ -140,34 +218,101 @@ STATUS alarm_stop(UINT32 alid)
 	return status;
 }
 
+STATUS alarm_set_slack(UINT32 alid, UINT32 slack)
+{
+	STATUS status = E_OK;
+	ALARM *alarm = (ALARM *)alid;
+
+	if (alarm == NULL)
+	{
+		status = E_ALARM_INVALID;
+	}
+	else
+	{
+		alarm->slack = slack;
+	}
+
+	service_error_check(S_ALARM_SET_SLACK, status);
+
+	return status;
+}
+
+#ifdef ALARM_THREAD
+/* the timer thread runs the handlers of expired alarms */
+void os_alarm_task(void *args)
+{
+	ALARM *alarm;
+	void (*handler)(UINT32);
+	UINT32 arg;
+
+	init_tqueue(&os_alarm_wait_q);
+
+	while (1)
+	{
+		os_sched_lock();
+
+		if ((alarm = os_alarm_head) == NULL)
+		{
+			os_wait_block(&os_alarm_wait_q, WAIT_FOREVER);
+			os_sched_unlock_switch();
+			continue;
+		}
+
+		os_alarm_head = alarm->next_pending;
+		if (os_alarm_head == NULL)
+		{
+			os_alarm_tail = NULL;
+		}
+		alarm->pending = FALSE;
+
+		/* the handler may destroy its own alarm */
+		handler = alarm->handler;
+		arg = alarm->arg;
+
+		os_sched_unlock();
+
+		handler(arg);
+	}
+}
+#endif
+
 /* os_alarm_handler is executed in ISR mode */
 static void os_alarm_exe(UINT32 alid) {
-	UINT32 calibrate_period = 0;
 	ALARM *alarm = (ALARM *)alid;
+#ifdef ALARM_THREAD
+	THREAD *thread;
 
+	/* hand the handler over to the timer thread */
+	if (!alarm->pending)
+	{
+		alarm->pending = TRUE;
+		alarm->next_pending = NULL;
+		if (os_alarm_tail != NULL)
+		{
+			os_alarm_tail->next_pending = alarm;
+		}
+		else
+		{
+			os_alarm_head = alarm;
+		}
+		os_alarm_tail = alarm;
+
+		if ((thread = pop_tnode(&os_alarm_wait_q)) != NULL)
+		{
+			os_wait_wakeup(thread);
+		}
+	}
+#else
 	/* 
 	   execute alarm handler since it is expired.
 	   alarm function is executed in ISR mode. 
 	*/
 
 	(alarm->handler)(alarm->arg);
-
-	if (tick_q.head != NULL) {
-		calibrate_period = tick_q.head->delta;
-	} // end if
-
-	if (calibrate_period <= alarm->work) {
-		calibrate_period = 0;
-	} else {
-		calibrate_period = calibrate_period - alarm->work;
-	} // end if
-
-	tick_q.head->delta = calibrate_period;
+#endif
 
 	/* schedule the next alarm */
 	if (alarm->cycle) { /* cyclic alarm */
-		if (SysTick_Reload_OverFlow == 0) {
-			tickq_Push(&alarm->alarm_dnode, (alarm->cycle - alarm->work));
-		} // end if
+		tickq_Push(&alarm->alarm_dnode, (alarm->cycle - alarm->work));
 	} // end if
 } // end func
@@ -20,22 +20,53 @@ typedef struct _alarm
 	UINT32  increment;			// first relative tick value
 	UINT32  cycle;				// periodic cycle value
 	UINT32	work;				// alarm function working time @phj.
+	UINT32	slack;				// ticks the alarm may be delayed for coalescing
 	DNODE	alarm_dnode;
 	void 	(*handler)(UINT32);	// function pointer
 	UINT32 	arg;				// function argument
+	BOOL	is_static;			// from alarm_init(), not freed by alarm_destroy()
+#ifdef ALARM_THREAD
+	struct _alarm *next_pending;	// expired, handler not run yet
+	BOOL	pending;
+#endif
 } ALARM;
 
+/*
+ * With ALARM_THREAD, the tick ISR only queues an expired alarm; its handler
+ * runs in the timer thread (CONFIG_ALARM_THREAD_PRIORITY). Thread wakeups
+ * and time slices are still handled in the ISR. An alarm that expires again
+ * before its handler ran is run only once. alarm_stop() and alarm_destroy()
+ * drop an expired alarm whose handler has not run yet.
+ */
+#ifndef CONFIG_ALARM_THREAD_PRIORITY
+#define CONFIG_ALARM_THREAD_PRIORITY	(PRIORITY_LEVEL_COUNT - 2)	// just below the super thread
+#endif
+
+void os_alarm_task(void *args);
+
 STATUS _alarm_spawn(void (*func)(UINT32), UINT32 arg, UINT32 increment, UINT32 cycle, UINT32 *alid, UINT32 work);
 UINT32 _alarm_create(void (*func)(UINT32), UINT32 arg, UINT32 increment, UINT32 cycle, UINT32 *alid, UINT32 work);
+UINT32 _alarm_init(ALARM *alarm, void (*func)(UINT32), UINT32 arg, UINT32 increment, UINT32 cycle, UINT32 *alid, UINT32 work);
 
 #define alarm_spawn(a1,a2,a3,a4,a5) (_alarm_spawn(a1,a2,a3,a4,a5,0))
 #define alarm_create(b1,b2,b3,b4,b5) (_alarm_create(b1,b2,b3,b4,b5,0))
+#define alarm_init(c0,c1,c2,c3,c4,c5) (_alarm_init(c0,c1,c2,c3,c4,c5,0))
 
 UINT32 alarm_destroy(UINT32 alid);
 UINT32 alarm_start(UINT32 alid);
 UINT32 alarm_stop(UINT32 alid);
 UINT32 alarm_get_cycle(UINT32 alid);
 
+/*
+ * The alarm may run up to slack ticks after its expiry, together with other
+ * expiries that fall in its window, so the CPU wakes up fewer times. A
+ * deferrable alarm never wakes the CPU; it runs at the first wakeup after its
+ * expiry. Cyclic alarms still keep their period from the expiry, not from
+ * the delayed run. Takes effect at the next alarm_start().
+ */
+#define ALARM_DEFERRABLE	DNODE_DEFERRABLE
+UINT32 alarm_set_slack(UINT32 alid, UINT32 slack);
+
 #define get_alarm_cycle(alid)	(alarm->cycle)
 typedef void 	(*ALARM_HANDLER)(UINT32);
 
@@ -18,7 +18,9 @@ void init_dqueue(DQUEUE *q)
 void init_dnode(DNODE *node, void (*handler)(UINT32), UINT32 arg)
 {
 	node->prev = node->next = NULL;
-	node->delta = 0;
+	node->expires = 0;
+	node->slot = DNODE_NOT_QUEUED;
+	node->slack = 0;
 	node->handler = handler;
 	node->arg = arg;
 }
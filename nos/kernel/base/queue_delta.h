@@ -10,13 +10,18 @@
 #define QUEUE_DELTA_H
 #include "typedef.h"
 
+#define DNODE_NOT_QUEUED	0xFFFF
+#define DNODE_DEFERRABLE	0xFFFFFFFF	// slack: never wakes the CPU on its own
+
 typedef struct _dnode
 {
-	UINT32 delta;
+	UINT32 expires;		// tick_q: absolute expiry tick
 	void (*handler)(UINT32);
 	UINT32 arg;
 	struct _dnode *prev;
 	struct _dnode *next;
+	UINT16 slot;		// tick_q: wheel slot, DNODE_NOT_QUEUED if not queued
+	UINT32 slack;		// tick_q: ticks the expiry may be delayed, set while not queued
 } DNODE;
 
 typedef struct _dqueue
@@ -40,6 +40,23 @@ void push_tnode(TQUEUE *q, THREAD *thread)
 	q->count++;
 }
 
+/* queues a thread behind the threads of higher or equal priority */
+void push_tnode_prio(TQUEUE *q, THREAD *thread)
+{
+	THREAD *p;
+
+	for (p = q->head; p != NULL; p = p->next)
+	{
+		if (p->priority < thread->priority)
+		{
+			add_tnode(q, p, thread);
+			return;
+		}
+	}
+
+	push_tnode(q, thread);
+}
+
 int add_tnode(TQUEUE *q, THREAD *p, THREAD *new_thread)
 {
 	if (p!=NULL) // thread is found
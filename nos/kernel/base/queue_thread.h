@@ -22,6 +22,7 @@ typedef struct _tqueue
 void init_tqueue(TQUEUE *q);
 void init_tnode(THREAD *thread);
 void push_tnode(TQUEUE *q, THREAD *thread);
+void push_tnode_prio(TQUEUE *q, THREAD *thread);
 int add_tnode(TQUEUE *q, THREAD *thread, THREAD *new_thread);
 int delete_tnode(TQUEUE *q, THREAD *thread);
 THREAD *pop_tnode(TQUEUE *q);
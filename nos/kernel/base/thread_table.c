@@ -9,61 +9,86 @@
 #include "thread.h"
 #include "sched.h"
 #include "queue_thread.h"
+#include "thread_table.h"
+#include "hal_sched.h"
 
 //#define OFFSET_OF(TYPE, MEMBER) ((unsigned int)(&((TYPE *)0)->MEMBER))
 
 extern TQUEUE 	os_rdy_q[PRIORITY_LEVEL_COUNT]; /* ready queue is an array of QUEUEs */
 
-/* management of tables */
-
-const UINT32 map_table[16]  = {0x0001, 0x0002, 0x0004, 0x0008, 0x0010, 0x0020, 0x0040, 0x0080,
-				 0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000, 0x8000};
-
-const UINT32 unmap_table[256]  = 
-			    {0,0,1,1,2,2,2,2,3,3,3,3,3,3,3,3,
-				4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
-				5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-				5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-				6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-				6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-				6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-				6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,
-				7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-				7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-				7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-				7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-				7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-				7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-				7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
-				7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7};
-
-UINT32 ready_table[16] = {0, };
+/*
+ * Ready bitmap: bit p is set while os_rdy_q[p] is not empty. The highest
+ * ready priority is found with CLZ (one instruction on Cortex-M4); up to 32
+ * levels fit in ready_group, 256 levels use a second level of 32-bit words
+ * summarized by ready_group.
+ */
+#ifndef NOS_CLZ
+#define NOS_CLZ(x)	__builtin_clz(x)
+#endif
+
+#define PRIO_MSB(x)	(31 - NOS_CLZ(x))	// x must not be 0
+
+#if PRIORITY_LEVEL_COUNT > 32
+UINT32 ready_table[PRIORITY_LEVEL_COUNT >> 5] = {0, };
+#endif
 UINT32 ready_group = 0;
 
 THREAD *highest_thread;
 
-static UINT32 is_tqueue_empty(TQUEUE *queue);
-static void os_calHighestThread(void);
-
 static UINT32 is_tqueue_empty(TQUEUE *queue)
 {
 	return (queue->head == NULL);
 }
 
+#ifdef EDF_SCHED
+/*
+ * The ready list of CONFIG_EDF_PRIORITY is kept sorted by absolute deadline,
+ * earliest first, so its head is the EDF thread to run and the bitmap lookup
+ * of os_calHighestThread() selects it unchanged. A thread goes behind those
+ * of equal deadline, so thread_yield() and time slices still rotate them.
+ */
+static void push_tnode_deadline(TQUEUE *q, THREAD *thread)
+{
+	THREAD *p;
+
+	for (p = q->head; p != NULL; p = p->next)
+	{
+		if (p->abs_deadline > thread->abs_deadline)
+		{
+			add_tnode(q, p, thread);
+			return;
+		}
+	}
+
+	push_tnode(q, thread);
+}
+#endif
+
 void os_qPush(THREAD *thread)
 {
 	UINT32 prio = thread->priority;
 
 	if (is_tqueue_empty(&os_rdy_q[prio]))
-	{	
-		ready_group             |= 	map_table[prio >>    4];
-		ready_table[prio >> 4]	|= 	map_table[prio &  0x0f];
+	{
+#if PRIORITY_LEVEL_COUNT <= 32
+		ready_group		|=	(1U << prio);
+#else
+		ready_group		|=	(1U << (prio >> 5));
+		ready_table[prio >> 5]	|=	(1U << (prio & 0x1f));
+#endif
 	}
 
 	/* enqueue error cannot occur
 	   already queue is checked if it is full 
 	 */
 	 
+#ifdef EDF_SCHED
+	if (prio == CONFIG_EDF_PRIORITY)
+	{
+		push_tnode_deadline(&os_rdy_q[prio], thread);
+	}
+	else
+#endif
 	push_tnode(&os_rdy_q[prio], thread);
 	os_calHighestThread();
 }
@@ -76,46 +101,32 @@ void os_qRemove(THREAD *thread)
 
 	if (is_tqueue_empty(&os_rdy_q[prio]))
 	{
-		if ((ready_table[prio >> 4] &= (UINT32)(~map_table[prio & 0x0f])) == 0)
+#if PRIORITY_LEVEL_COUNT <= 32
+		ready_group &= ~(1U << prio);
+#else
+		if ((ready_table[prio >> 5] &= ~(1U << (prio & 0x1f))) == 0)
 		{
-			ready_group &= (UINT32)(~map_table[prio >> 4]);
+			ready_group &= ~(1U << (prio >> 5));
 		}
+#endif
 	}
 	os_calHighestThread();
 }
 
-static void os_calHighestThread(void)
+void os_calHighestThread(void)
 {
-	UINT32 x, y, prio;
-	//NODE *highestNode;
-
-    	// find y
-    	y = ready_group;
-    	if (y>>8) // upper nibble
-    	{
-       		y = (UINT32)(unmap_table[y>>8] + 8);
-    	}
-    	else
-    	{
-       		y = unmap_table[y & 0xff]; // lower nibble
-    	}
-
-    	// find x
-    	x = ready_table[y];
-    	if (x>>8) // upper nibble
-    	{
-       		x = (UINT32)(unmap_table[x>>8] + 8);
-    	}
-	else
-    	{
-       		x = unmap_table[x & 0xff]; // lower nibble
-	}
-	
-	prio = (y << 4) + x;
+	UINT32 prio = 0;
 
-	//highestNode = os_rdy_q[prio].head;
-	//highest_thread = (THREAD *) ((UINT32)highestNode - OFFSET_OF(_TCB, rdy_node));
+	if (ready_group)
+	{
+#if PRIORITY_LEVEL_COUNT <= 32
+		prio = PRIO_MSB(ready_group);
+#else
+		UINT32 y = PRIO_MSB(ready_group);
+
+		prio = (y << 5) + PRIO_MSB(ready_table[y]);
+#endif
+	}
 
 	highest_thread = os_rdy_q[prio].head;
 }
-
@@ -14,4 +14,5 @@
 /* ready queue management */
 void os_qPush(THREAD *thread);
 void os_qRemove(THREAD *thread);
+void os_calHighestThread(void);
 #endif
@@ -0,0 +1,211 @@
+//===================================================================
+//
+// coro.c
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+
+#include "kconf.h"
+
+#ifdef CORO_M
+
+#include "coro.h"
+
+#include "critical_section.h"
+#include "sched.h"
+#include "thread.h"
+#include "tick.h"
+#include "error.h"
+
+/* one run of the body, on the executor thread */
+static void os_coro_run(void *args)
+{
+	CORO *co = (CORO *)args;
+
+	switch (co->func(co))
+	{
+		case CORO_YIELDED:
+			work_submit(co->exec, &co->work);
+			break;
+
+		case CORO_DONE:
+			co->done = 1;
+			break;
+
+		default:	/* CORO_WAITING: a wake-up submits it again */
+			break;
+	}
+}
+
+/* takes the coroutine out of its wait queue (scheduler locked) */
+static void os_coro_unlink(CORO *co)
+{
+	CORO **p;
+
+	if (co->waitq != NULL)
+	{
+		for (p = &co->waitq->head; *p != NULL; p = &(*p)->wait_next)
+		{
+			if (*p == co)
+			{
+				*p = co->wait_next;
+				break;
+			}
+		}
+		co->waitq = NULL;
+		co->wait_next = NULL;
+	}
+}
+
+/* tick_q handler (ISR mode) */
+static void os_coro_timeout(UINT32 arg)
+{
+	CORO *co = (CORO *)arg;
+
+	co->timed_out = 1;
+	coro_wake(co);
+}
+
+void coro_init(CORO *co, CORO_FUNC func, void *args)
+{
+	work_init(&co->work, os_coro_run, co);
+	co->exec = 0;
+	co->func = func;
+	co->args = args;
+	co->lc = 0;
+	co->done = 0;
+	co->timed_out = 0;
+	co->events = 0;
+	co->waitq = NULL;
+	co->wait_next = NULL;
+	init_dnode(&co->timer, os_coro_timeout, (UINT32)co);
+}
+
+// The coroutine runs on the worker of work queue wqid.
+STATUS coro_start(UINT32 wqid, CORO *co)
+{
+	STATUS status;
+
+	co->exec = wqid;
+	co->lc = 0;
+	co->done = 0;
+
+	status = work_submit(wqid, &co->work);
+
+	service_error_check(S_CORO_START, status);
+
+	return status;
+}
+
+// It can be called in ISR mode.
+void coro_wake(CORO *co)
+{
+	os_sched_lock();
+
+	os_coro_unlink(co);
+	if (!co->done)
+	{
+		os_work_queue((WORKQ *)co->exec, &co->work);
+	}
+
+	os_sched_unlock_switch();
+}
+
+// It can be called in ISR mode.
+void coro_event_set(CORO *co, UINT32 mask)
+{
+	os_sched_lock();
+
+	co->events |= mask;
+	os_coro_unlink(co);
+	if (!co->done)
+	{
+		os_work_queue((WORKQ *)co->exec, &co->work);
+	}
+
+	os_sched_unlock_switch();
+}
+
+UINT32 coro_event_take(CORO *co, UINT32 mask)
+{
+	UINT32 got;
+
+	os_sched_lock();
+	got = co->events & mask;
+	co->events &= ~got;
+	os_sched_unlock();
+
+	return got;
+}
+
+void coro_waitq_init(CORO_WAITQ *wq)
+{
+	wq->head = NULL;
+}
+
+// Wakes every coroutine of the queue. It can be called in ISR mode.
+void coro_waitq_wake(CORO_WAITQ *wq)
+{
+	CORO *co;
+
+	if (wq->head == NULL)	/* a coroutine queued now checks its condition after */
+	{
+		return;
+	}
+
+	os_sched_lock();
+
+	while ((co = wq->head) != NULL)
+	{
+		wq->head = co->wait_next;
+		co->waitq = NULL;
+		co->wait_next = NULL;
+		os_work_queue((WORKQ *)co->exec, &co->work);
+	}
+
+	os_sched_unlock_switch();
+}
+
+void coro_timer_start(CORO *co, UINT32 ticks)
+{
+	os_sched_lock();
+
+	tickq_Remove(&co->timer);
+	co->timed_out = (ticks == 0);
+	if ((ticks != 0) && (ticks != WAIT_FOREVER))
+	{
+		tickq_Push(&co->timer, ticks);
+	}
+
+	os_sched_unlock();
+}
+
+/* queues the coroutine before its wait condition is checked */
+void coro_park(CORO *co, CORO_WAITQ *wq)
+{
+	os_sched_lock();
+
+	if (co->waitq != wq)
+	{
+		os_coro_unlink(co);
+		co->waitq = wq;
+		co->wait_next = wq->head;
+		wq->head = co;
+	}
+
+	os_sched_unlock();
+}
+
+/* the wait is over: leaves the queue and stops the timeout */
+void coro_unpark(CORO *co)
+{
+	os_sched_lock();
+
+	os_coro_unlink(co);
+	tickq_Remove(&co->timer);
+
+	os_sched_unlock();
+}
+
+#endif // CORO_M
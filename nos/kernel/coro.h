@@ -0,0 +1,131 @@
+//===================================================================
+//
+// coro.h
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+#ifndef CORO_H
+#define CORO_H
+#include "kconf.h"
+
+#ifdef CORO_M
+
+#include "nos_common.h"
+#include "queue_delta.h"
+#include "workq.h"
+
+/*
+ * Stackless coroutines (protothreads). A coroutine is a function that runs
+ * on the worker thread of a work queue (the executor) and returns instead
+ * of blocking; the next call resumes it after the point it returned from.
+ * Many coroutines share one executor and its stack, and each one costs a
+ * CORO of RAM only.
+ *
+ * The body is written between CORO_BEGIN() and CORO_END(). Local variables
+ * are not kept across a wait or a yield: keep the state in the CORO args.
+ * The wait macros may not be used inside a switch statement of the body.
+ *
+ *	static int blink(CORO *co)
+ *	{
+ *		CORO_BEGIN(co);
+ *		while (1)
+ *		{
+ *			led_toggle(0);
+ *			CORO_SLEEP(co, SEC(1));
+ *		}
+ *		CORO_END(co);
+ *	}
+ *
+ * A waiting coroutine is resumed by coro_wake(), coro_event_set(), the end
+ * of its timeout, or a change of the message queue or event group it waits
+ * for. The wait condition is evaluated again each time, so wake-ups that
+ * do not satisfy it are harmless.
+ */
+
+#define CORO_WAITING	0	// waits for a wake-up
+#define CORO_YIELDED	1	// runs again after the other ready coroutines
+#define CORO_DONE	2	// ended
+
+struct _coro;
+typedef int (*CORO_FUNC)(struct _coro *co);
+
+typedef struct _coro_waitq
+{
+	struct _coro	*head;		// coroutines waiting for the object
+} CORO_WAITQ;
+
+typedef struct _coro
+{
+	WORK		work;		// a run of the body on the executor
+	UINT32		exec;		// work queue id of the executor
+	CORO_FUNC	func;
+	void		*args;
+	UINT16		lc;		// resume point (source line), 0 at the start
+	UINT8		done;
+	UINT8		timed_out;	// the timeout of the last wait has passed
+	UINT32		events;		// coro_event_set() flags not taken yet
+	CORO_WAITQ	*waitq;		// the queue it waits in, NULL if none
+	struct _coro	*wait_next;
+	DNODE		timer;		// CORO_SLEEP() and wait timeouts
+} CORO;
+
+#define CORO_BEGIN(co)		switch ((co)->lc) { case 0:
+#define CORO_END(co)		} (co)->lc = 0; return CORO_DONE
+
+#define CORO_YIELD(co) \
+	do { (co)->lc = __LINE__; return CORO_YIELDED; case __LINE__:; } while (0)
+
+/* cond is evaluated now and at each wake-up */
+#define CORO_WAIT_UNTIL(co, cond) \
+	do { (co)->lc = __LINE__; case __LINE__: if (!(cond)) return CORO_WAITING; } while (0)
+
+#define CORO_SLEEP(co, ticks) \
+	do { coro_timer_start((co), (ticks)); CORO_WAIT_UNTIL((co), (co)->timed_out); } while (0)
+
+/* waits in waitq until cond or timeout (ticks, WAIT_FOREVER); see coro_timed_out() */
+#define CORO_WAIT_ON(co, wq, cond, timeout) \
+	do { \
+		coro_timer_start((co), (timeout)); \
+		(co)->lc = __LINE__; case __LINE__: \
+		coro_park((co), (wq)); \
+		if (!(cond) && !(co)->timed_out) return CORO_WAITING; \
+		coro_unpark(co); \
+	} while (0)
+
+/* status is E_OK, or E_MSGQ_EMPTY / E_MSGQ_FULL after the timeout */
+#define CORO_MSGQ_RECV(co, mqid, data, timeout, status) \
+	CORO_WAIT_ON((co), &((MSGQ *)(mqid))->coro_wait, \
+		     ((status) = msgq_recv((mqid), (data))) == E_OK, (timeout))
+#define CORO_MSGQ_SEND(co, mqid, data, timeout, status) \
+	CORO_WAIT_ON((co), &((MSGQ *)(mqid))->coro_wait, \
+		     ((status) = msgq_send((mqid), (data))) == E_OK, (timeout))
+
+/* status is E_OK, or E_TIMEOUT after the timeout */
+#define CORO_EVENT_GROUP_WAIT(co, egid, mask, option, flags, timeout, status) \
+	CORO_WAIT_ON((co), &((EVENT_GROUP *)(egid))->coro_wait, \
+		     ((status) = event_group_wait((egid), (mask), (option), (flags), 0)) == E_OK, (timeout))
+
+/* waits for any flag of mask from coro_event_set(); got receives (and clears) them */
+#define CORO_EVENT_WAIT(co, mask, got) \
+	CORO_WAIT_UNTIL((co), ((got) = coro_event_take((co), (mask))) != 0)
+
+#define coro_is_done(co)	((co)->done)
+#define coro_timed_out(co)	((co)->timed_out)
+
+void coro_init(CORO *co, CORO_FUNC func, void *args);
+UINT32 coro_start(UINT32 wqid, CORO *co);
+void coro_wake(CORO *co);
+void coro_event_set(CORO *co, UINT32 mask);
+UINT32 coro_event_take(CORO *co, UINT32 mask);
+
+void coro_waitq_init(CORO_WAITQ *wq);
+void coro_waitq_wake(CORO_WAITQ *wq);
+
+// used by the wait macros
+void coro_timer_start(CORO *co, UINT32 ticks);
+void coro_park(CORO *co, CORO_WAITQ *wq);
+void coro_unpark(CORO *co);
+
+#endif // CORO_M
+#endif // ~CORO_H
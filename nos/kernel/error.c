@@ -14,6 +14,7 @@
 const char *service_name[] = 
 {
       	"THREAD_CREATE",
+        "THREAD_INIT",
         "THREAD_TERMINATE",
         "THREAD_EXIT",
         "THREAD_ACTIVATE",
@@ -22,24 +23,56 @@ const char *service_name[] =
         "THREAD_WAIT",
         "THREAD_RESUME",
         "THREAD_PRIORITY_CHANGE",
+        "THREAD_SET_QUANTUM",
+        "THREAD_SET_PERIODIC",
+        "THREAD_WAIT_NEXT_PERIOD",
+        "THREAD_SET_EDF",
+        "THREAD_SET_DEADLINE",
         "ALARM_CREATE",
+        "ALARM_INIT",
         "ALARM_DESTROY",
         "ALARM_START",
         "ALARM_STOP",
+        "ALARM_SET_SLACK",
         "EVENT_CLEAR",
         "EVENT_GET",
         "EVENT_SET",
         "EVENT_WAIT",
+        "EVENT_GROUP_CREATE",
+        "EVENT_GROUP_INIT",
+        "EVENT_GROUP_DESTROY",
+        "EVENT_GROUP_SET",
+        "EVENT_GROUP_CLEAR",
+        "EVENT_GROUP_WAIT",
         "MSGQ_CREATE",
+        "MSGQ_INIT",
         "MSGQ_DESTROY",
         "MSGQ_SEND",
         "MSGQ_RECV",
+        "MSGPOOL_CREATE",
+        "MSGPOOL_INIT",
+        "MSGPOOL_DESTROY",
+        "MSGBUF_FREE",
+        "MEMPOOL_CREATE",
+        "MEMPOOL_INIT",
+        "MEMPOOL_DESTROY",
+        "MEMPOOL_SET_BACKING",
+        "MEMPOOL_FREE",
         "MUTEX_CREATE",
+        "MUTEX_INIT",
         "MUTEX_DESTROY",
-        "MUTEX_GET",
-        "MUTEX_GET_TRY_COUNT_LIMIT",
-        "MUTEX_RELEASE",
-        "TASKQ_REGISTER"
+        "MUTEX_LOCK",
+        "MUTEX_UNLOCK",
+        "SEM_CREATE",
+        "SEM_INIT",
+        "SEM_DESTROY",
+        "SEM_WAIT",
+        "SEM_POST",
+        "TASKQ_REGISTER",
+        "WORKQ_CREATE",
+        "WORKQ_INIT",
+        "WORK_SUBMIT",
+        "CORO_START"
 };
 
 const char *error_name[] = 
@@ -73,7 +106,15 @@ const char *error_name[] =
         "E_MSGQ_INVALID",
         "E_MSGQ_FULL",
         "E_MSGQ_EMPTY",
-        "E_TASKQ_FULL"
+        "E_TASKQ_FULL",
+        "E_TIMEOUT",
+        "E_SEM_INVALID",
+        "E_SEM_FULL",
+        "E_MSGPOOL_INVALID",
+        "E_MSGPOOL_BUF",
+        "E_MEMPOOL_INVALID",
+        "E_EVENT_GROUP_INVALID",
+        "E_WORKQ_INVALID"
 };
 
 void service_error_check(UINT32 service_id, STATUS status)
@@ -44,12 +44,21 @@ enum OS_ERR_TYPE
 	E_MSGQ_INVALID,
 	E_MSGQ_FULL,
 	E_MSGQ_EMPTY,
-	E_TASKQ_FULL
+	E_TASKQ_FULL,
+	E_TIMEOUT,
+	E_SEM_INVALID,
+	E_SEM_FULL,
+	E_MSGPOOL_INVALID,
+	E_MSGPOOL_BUF,
+	E_MEMPOOL_INVALID,
+	E_EVENT_GROUP_INVALID,
+	E_WORKQ_INVALID
 };
 
 enum OS_SERVICE_TYPE
 {
 	S_THREAD_CREATE = 0,
+	S_THREAD_INIT,
 	S_THREAD_TERMINATE,
 	S_THREAD_EXIT,
 	S_THREAD_ACTIVATE,
@@ -58,23 +67,56 @@ enum OS_SERVICE_TYPE
 	S_THREAD_WAIT,
 	S_THREAD_WAKEUP,
 	S_THREAD_PRIORITY_CHANGE,
+	S_THREAD_SET_QUANTUM,
+	S_THREAD_SET_PERIODIC,
+	S_THREAD_WAIT_NEXT_PERIOD,
+	S_THREAD_SET_EDF,
+	S_THREAD_SET_DEADLINE,
 	S_ALARM_CREATE,
+	S_ALARM_INIT,
 	S_ALARM_DESTROY,
 	S_ALARM_START,
 	S_ALARM_STOP,
+	S_ALARM_SET_SLACK,
 	S_EVENT_CLEAR,
 	S_EVENT_GET,
 	S_EVENT_SET,
 	S_EVENT_WAIT,
+	S_EVENT_GROUP_CREATE,
+	S_EVENT_GROUP_INIT,
+	S_EVENT_GROUP_DESTROY,
+	S_EVENT_GROUP_SET,
+	S_EVENT_GROUP_CLEAR,
+	S_EVENT_GROUP_WAIT,
 	S_MSGQ_CREATE,
+	S_MSGQ_INIT,
 	S_MSGQ_DESTROY,
 	S_MSGQ_SEND,
 	S_MSGQ_RECV,
+	S_MSGPOOL_CREATE,
+	S_MSGPOOL_INIT,
+	S_MSGPOOL_DESTROY,
+	S_MSGBUF_FREE,
+	S_MEMPOOL_CREATE,
+	S_MEMPOOL_INIT,
+	S_MEMPOOL_DESTROY,
+	S_MEMPOOL_SET_BACKING,
+	S_MEMPOOL_FREE,
 	S_MUTEX_CREATE,
+	S_MUTEX_INIT,
 	S_MUTEX_DESTROY,
 	S_MUTEX_LOCK,
 	S_MUTEX_UNLOCK,
-	S_TASKQ_REGISTER
+	S_SEM_CREATE,
+	S_SEM_INIT,
+	S_SEM_DESTROY,
+	S_SEM_WAIT,
+	S_SEM_POST,
+	S_TASKQ_REGISTER,
+	S_WORKQ_CREATE,
+	S_WORKQ_INIT,
+	S_WORK_SUBMIT,
+	S_CORO_START
 };
 
 void service_error_check(UINT32 fid, STATUS status);
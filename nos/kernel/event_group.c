@@ -0,0 +1,260 @@
+//===================================================================
+//
+// event_group.c
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+
+#include "event_group.h"
+
+#include "sched.h"
+#include "heap.h"
+#include "mempool.h"
+#include "critical_section.h"
+#include "thread.h"
+#include "queue_thread.h"
+#include "error.h"
+
+static BOOL event_group_satisfied(UINT32 flags, UINT32 mask, UINT32 option)
+{
+	if (option & EG_WAIT_ALL)
+	{
+		return ((flags & mask) == mask);
+	}
+	return ((flags & mask) != 0);
+}
+
+static void os_event_group_setup(EVENT_GROUP *group, UINT32 init_flags, BOOL is_static)
+{
+	group->flags = init_flags;
+	group->is_static = is_static;
+	init_tqueue(&group->wait_queue);
+#ifdef CORO_M
+	coro_waitq_init(&group->coro_wait);
+#endif
+}
+
+STATUS event_group_create(UINT32 *egid, UINT32 init_flags)
+{
+	STATUS status = E_OK;
+	EVENT_GROUP *group;
+
+	if ((group = os_kobj_alloc(KOBJ_EVENT_GROUP, sizeof(struct _event_group))) == NULL)
+	{
+		status = E_SYS_MEMORY;
+	}
+	else
+	{
+		os_event_group_setup(group, init_flags, FALSE);
+
+		*egid = (UINT32)group;
+	}
+
+	service_error_check(S_EVENT_GROUP_CREATE, status);
+
+	return status;
+}
+
+// Same as event_group_create(), in the caller's storage.
+STATUS event_group_init(EVENT_GROUP *group, UINT32 *egid, UINT32 init_flags)
+{
+	STATUS status = E_OK;
+
+	if (group == NULL)
+	{
+		status = E_EVENT_GROUP_INVALID;
+	}
+	else
+	{
+		os_event_group_setup(group, init_flags, TRUE);
+
+		*egid = (UINT32)group;
+	}
+
+	service_error_check(S_EVENT_GROUP_INIT, status);
+
+	return status;
+}
+
+STATUS event_group_destroy(UINT32 egid)
+{
+	STATUS status = E_OK;
+	EVENT_GROUP *group = (EVENT_GROUP *)egid;
+
+	if (group == NULL)
+	{
+		status = E_EVENT_GROUP_INVALID;
+	}
+	else if (group->wait_queue.head != NULL)
+	{
+		status = E_OS_PERMISSION;	/* threads are waiting for it */
+	}
+	else
+	{
+		os_sched_lock();
+
+		if (!group->is_static)
+		{
+			os_kobj_free(KOBJ_EVENT_GROUP, group);
+		}
+
+		os_sched_unlock();
+	}
+
+	service_error_check(S_EVENT_GROUP_DESTROY, status);
+
+	return status;
+}
+
+// It can be called in ISR mode.
+STATUS event_group_set(UINT32 egid, UINT32 mask)
+{
+	STATUS status = E_OK;
+	EVENT_GROUP *group = (EVENT_GROUP *)egid;
+	THREAD *thread, *next;
+	EG_WAIT *wait;
+	UINT32 clear = 0;
+
+	if (group == NULL)
+	{
+		status = E_EVENT_GROUP_INVALID;
+	}
+	else
+	{
+		os_sched_lock();
+
+		group->flags |= mask;
+
+		/* wake up every satisfied waiter, then clear what they consume */
+		for (thread = group->wait_queue.head; thread != NULL; thread = next)
+		{
+			next = thread->next;
+			wait = thread->wait_buf;
+
+			if (event_group_satisfied(group->flags, wait->mask, wait->option))
+			{
+				wait->flags = group->flags;
+				if (wait->option & EG_AUTO_CLEAR)
+				{
+					clear |= wait->mask;
+				}
+
+				delete_tnode(&group->wait_queue, thread);
+				os_wait_wakeup(thread);
+			}
+		}
+		group->flags &= ~clear;
+
+		os_sched_unlock_switch();
+
+#ifdef CORO_M
+		coro_waitq_wake(&group->coro_wait);
+#endif
+	}
+
+	service_error_check(S_EVENT_GROUP_SET, status);
+
+	return status;
+}
+
+// It can be called in ISR mode.
+STATUS event_group_clear(UINT32 egid, UINT32 mask)
+{
+	STATUS status = E_OK;
+	EVENT_GROUP *group = (EVENT_GROUP *)egid;
+
+	if (group == NULL)
+	{
+		status = E_EVENT_GROUP_INVALID;
+	}
+	else
+	{
+		os_sched_lock();
+
+		group->flags &= ~mask;
+
+		os_sched_unlock();
+	}
+
+	service_error_check(S_EVENT_GROUP_CLEAR, status);
+
+	return status;
+}
+
+UINT32 event_group_get(UINT32 egid)
+{
+	EVENT_GROUP *group = (EVENT_GROUP *)egid;
+
+	return group->flags;
+}
+
+/*
+ * Waits for any (EG_WAIT_ANY) or all (EG_WAIT_ALL) of the flags in mask, for
+ * at most timeout ticks. flags (may be NULL) receives the flags of the group
+ * when the wait ended, before an EG_AUTO_CLEAR.
+ */
+STATUS event_group_wait(UINT32 egid, UINT32 mask, UINT32 option, UINT32 *flags, UINT32 timeout)
+{
+	STATUS status = E_OK;
+	EVENT_GROUP *group = (EVENT_GROUP *)egid;
+	EG_WAIT wait;
+
+	if (NOS_IS_ISR_MODE())
+	{
+		status = E_EVENT_MODE;
+	}
+	else if ((group == NULL) || (mask == 0))
+	{
+		status = E_EVENT_GROUP_INVALID;
+	}
+	else
+	{
+		os_sched_lock();
+
+		if (event_group_satisfied(group->flags, mask, option))
+		{
+			wait.flags = group->flags;
+			if (option & EG_AUTO_CLEAR)
+			{
+				group->flags &= ~mask;
+			}
+
+			os_sched_unlock();
+		}
+		else if (timeout == 0)
+		{
+			wait.flags = group->flags;
+			status = E_TIMEOUT;
+
+			os_sched_unlock();
+		}
+		else
+		{
+			wait.mask = mask;
+			wait.option = option;
+			current_thread->wait_buf = &wait;
+			os_wait_block(&group->wait_queue, timeout);
+
+			os_sched_unlock_switch();
+
+			if ((status = current_thread->wait_status) != E_OK)
+			{
+				wait.flags = group->flags;
+			}
+		}
+
+		if (flags != NULL)
+		{
+			*flags = wait.flags;
+		}
+		if (status == E_TIMEOUT)
+		{
+			return status;
+		}
+	}
+
+	service_error_check(S_EVENT_GROUP_WAIT, status);
+
+	return status;
+}
@@ -0,0 +1,54 @@
+//===================================================================
+//
+// event_group.h
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+#ifndef EVENT_GROUP_H
+#define EVENT_GROUP_H
+#include "kconf.h"
+#include "queue_thread.h"
+#include "coro.h"
+
+#include "nos_common.h"
+
+/*
+ * A set of 32 event flags shared by any number of threads. A thread waits
+ * for any or all of a mask of flags; event_group_set() wakes every waiter
+ * it satisfies in one pass and can be called from an ISR. With
+ * EG_AUTO_CLEAR, the flags a waiter waited for are cleared once it is
+ * satisfied (after all waiters have been checked, so a broadcast reaches
+ * every one of them).
+ */
+typedef struct _event_group
+{
+	UINT32	flags;
+	TQUEUE	wait_queue;	// ordered by priority, FIFO among equals
+	BOOL	is_static;	// from event_group_init(), not freed by event_group_destroy()
+#ifdef CORO_M
+	CORO_WAITQ coro_wait;	// coroutines (CORO_EVENT_GROUP_WAIT)
+#endif
+} EVENT_GROUP;
+
+// event_group_wait() options
+#define EG_WAIT_ANY	(0x00)
+#define EG_WAIT_ALL	(0x01)
+#define EG_AUTO_CLEAR	(0x02)
+
+typedef struct _eg_wait
+{
+	UINT32	mask;
+	UINT32	option;
+	UINT32	flags;		// the flags when the wait ended
+} EG_WAIT;			// condition of a waiter (THREAD.wait_buf)
+
+UINT32 event_group_create(UINT32 *egid, UINT32 init_flags);
+UINT32 event_group_init(EVENT_GROUP *group, UINT32 *egid, UINT32 init_flags);
+UINT32 event_group_destroy(UINT32 egid);
+UINT32 event_group_set(UINT32 egid, UINT32 mask);
+UINT32 event_group_clear(UINT32 egid, UINT32 mask);
+UINT32 event_group_get(UINT32 egid);
+UINT32 event_group_wait(UINT32 egid, UINT32 mask, UINT32 option, UINT32 *flags, UINT32 timeout);
+
+#endif // EVENT_GROUP_H
@@ -0,0 +1,161 @@
+//===================================================================
+//
+// hrtimer.c
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+
+#include "hrtimer.h"
+
+#ifdef HRTIMER_M
+#include "hal_hrtimer.h"
+#include "critical_section.h"
+#include "sched.h"
+
+static HRTIMER *os_hrtimer_head;	/* queued timers, earliest deadline first */
+static BOOL os_hrtimer_expiring;	/* os_hrtimer_isr() programs the compare when done */
+
+/* timers with the same deadline expire in the order they were started */
+static void os_hrtimer_link(HRTIMER *timer)
+{
+	HRTIMER *p, *prev = NULL;
+
+	for (p = os_hrtimer_head; (p != NULL) && !HRTIME_BEFORE(timer->expires, p->expires); p = p->next)
+	{
+		prev = p;
+	}
+
+	timer->prev = prev;
+	timer->next = p;
+	if (p != NULL)
+	{
+		p->prev = timer;
+	}
+	if (prev != NULL)
+	{
+		prev->next = timer;
+	}
+	else
+	{
+		os_hrtimer_head = timer;
+	}
+	timer->queued = TRUE;
+}
+
+static void os_hrtimer_unlink(HRTIMER *timer)
+{
+	if (timer->prev != NULL)
+	{
+		timer->prev->next = timer->next;
+	}
+	else
+	{
+		os_hrtimer_head = timer->next;
+	}
+	if (timer->next != NULL)
+	{
+		timer->next->prev = timer->prev;
+	}
+	timer->prev = timer->next = NULL;
+	timer->queued = FALSE;
+}
+
+static void os_hrtimer_program(void)
+{
+	if (os_hrtimer_head != NULL)
+	{
+		/* interrupts right away if the deadline has passed already */
+		nos_hrtimer_hal_set(os_hrtimer_head->expires);
+	}
+	else
+	{
+		nos_hrtimer_hal_stop();
+	}
+}
+
+void os_hrtimer_init(void)
+{
+	os_hrtimer_head = NULL;
+	os_hrtimer_expiring = FALSE;
+	nos_hrtimer_hal_init();
+}
+
+void hrtimer_init(HRTIMER *timer, void (*func)(void *args), void *args)
+{
+	timer->prev = timer->next = NULL;
+	timer->expires = 0;
+	timer->func = func;
+	timer->args = args;
+	timer->queued = FALSE;
+}
+
+UINT32 hrtimer_now(void)
+{
+	return nos_hrtimer_hal_now();
+}
+
+// It can be called in ISR mode, from a callback too.
+void hrtimer_start_at(HRTIMER *timer, UINT32 when)
+{
+	os_sched_lock();
+
+	if (timer->queued)
+	{
+		os_hrtimer_unlink(timer);
+	}
+	timer->expires = when;
+	os_hrtimer_link(timer);
+
+	if ((os_hrtimer_head == timer) && !os_hrtimer_expiring)
+	{
+		os_hrtimer_program();
+	}
+
+	os_sched_unlock();
+}
+
+void hrtimer_start(HRTIMER *timer, UINT32 us)
+{
+	hrtimer_start_at(timer, nos_hrtimer_hal_now() + us);
+}
+
+/* Returns FALSE if the timer was not queued. */
+BOOL hrtimer_cancel(HRTIMER *timer)
+{
+	BOOL queued;
+
+	os_sched_lock();
+
+	if ((queued = timer->queued) != FALSE)
+	{
+		os_hrtimer_unlink(timer);
+		/* a compare for a removed head only causes an empty interrupt */
+	}
+
+	os_sched_unlock();
+
+	return queued;
+}
+
+/* called by the compare interrupt handler */
+void os_hrtimer_isr(void)
+{
+	HRTIMER *timer;
+
+	os_sched_lock();
+	os_hrtimer_expiring = TRUE;
+
+	while (((timer = os_hrtimer_head) != NULL) && !HRTIME_BEFORE(nos_hrtimer_hal_now(), timer->expires))
+	{
+		os_hrtimer_unlink(timer);
+		timer->func(timer->args);	/* may restart the timer */
+	}
+
+	os_hrtimer_expiring = FALSE;
+	os_hrtimer_program();
+
+	os_sched_unlock();
+}
+
+#endif // HRTIMER_M
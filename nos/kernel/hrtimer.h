@@ -0,0 +1,54 @@
+//===================================================================
+//
+// hrtimer.h
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+#ifndef HRTIMER_H
+#define HRTIMER_H
+#include "kconf.h"
+
+#ifdef HRTIMER_M
+#include "nos_common.h"
+
+/*
+ * High-resolution timers. Deadlines are microseconds of a free-running 32-bit
+ * counter (TIM2 on the STM32F4), independent of the scheduler tick. All timers
+ * share one compare interrupt, programmed for the earliest deadline of a
+ * sorted queue. Timers are caller-allocated, so starting one never fails.
+ * The callbacks run in ISR mode.
+ *
+ * Times wrap after about 71 minutes; a deadline must lie within 35 minutes
+ * of the current time.
+ */
+typedef struct _hrtimer
+{
+	struct _hrtimer	*prev, *next;
+	UINT32		expires;	// absolute deadline (us)
+	void		(*func)(void *args);
+	void		*args;
+	BOOL		queued;
+} HRTIMER;
+
+#define HRTIMER_INITIALIZER(f, a)	{ NULL, NULL, 0, (f), (a), FALSE }
+
+// TRUE if time a comes before time b
+#define HRTIME_BEFORE(a, b)	((INT32)((a) - (b)) < 0)
+
+void hrtimer_init(HRTIMER *timer, void (*func)(void *args), void *args);
+void hrtimer_start(HRTIMER *timer, UINT32 us);
+void hrtimer_start_at(HRTIMER *timer, UINT32 when);
+BOOL hrtimer_cancel(HRTIMER *timer);
+UINT32 hrtimer_now(void);
+
+/* a periodic timer restarts itself from its last deadline, so it does not drift */
+#define hrtimer_forward(timer, us)	hrtimer_start_at((timer), (timer)->expires + (us))
+#define hrtimer_expires(timer)		((timer)->expires)
+#define hrtimer_is_queued(timer)	((timer)->queued)
+
+void os_hrtimer_init(void);
+void os_hrtimer_isr(void);
+
+#endif // HRTIMER_M
+#endif // ~HRTIMER_H
@@ -26,6 +26,10 @@ int main(void)
 void nos_kernel_init()
 {
    	os_sched_init();
+
+#ifdef USER_TIMER_M
+	nos_user_timer_init();
+#endif
 	
 	os_taskq_init();
 }
@@ -11,10 +11,19 @@
 #include "sched.h"
 #include "thread.h"
 #include "taskq.h"
+#include "workq.h"
+#include "coro.h"
 #include "alarm.h"
+#include "hrtimer.h"
+#include "user_timer.h"
+#include "tick.h"
 #include "event.h"
+#include "event_group.h"
 #include "mutex.h"
+#include "sem.h"
 #include "msgq.h"
+#include "msgpool.h"
+#include "mempool.h"
 #include "time.h"
 
 void nos_kernel_init(void);
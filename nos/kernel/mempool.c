@@ -0,0 +1,322 @@
+//===================================================================
+//
+// mempool.c
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+
+#include "mempool.h"
+
+#include "heap.h"
+#include "critical_section.h"
+#include "sched.h"
+#include "error.h"
+
+#ifdef MEMPOOL_KOBJ
+#include "thread.h"
+#include "alarm.h"
+#include "mutex.h"
+#include "sem.h"
+#include "msgq.h"
+#include "event_group.h"
+#endif
+
+static void os_mempool_setup(MEMPOOL *pool, void *mem, UINT32 block_size, UINT32 count, BOOL is_static)
+{
+	pool->free_list = NULL;
+	pool->block_size = MEMPOOL_BLOCK_SIZE(block_size);
+	pool->mem = mem;
+	pool->mem_end = pool->mem + pool->block_size * count;
+	pool->next = pool->mem;
+	pool->end = pool->mem_end;
+	pool->backing = pool->backing_end = NULL;
+	pool->used = 0;
+	pool->max_used = 0;
+	pool->alloc_count = 0;
+	pool->alloc_fail = 0;
+	pool->grown = 0;
+	pool->is_static = is_static;
+}
+
+STATUS mempool_create(UINT32 block_size, UINT32 count, UINT32 *mpid)
+{
+	STATUS status = E_OK;
+	MEMPOOL *pool;
+	void *mem = NULL;
+
+	if (block_size == 0)
+	{
+		status = E_MEMPOOL_INVALID;
+	}
+	else if ((pool = nos_malloc(sizeof(struct _mempool))) == NULL)
+	{
+		status = E_SYS_MEMORY;
+	}
+	else if ((count != 0) && ((mem = nos_malloc(MEMPOOL_BLOCK_SIZE(block_size) * count)) == NULL))
+	{
+		nos_free(pool);
+		status = E_SYS_MEMORY;
+	}
+	else
+	{
+		os_mempool_setup(pool, mem, block_size, count, FALSE);
+
+		*mpid = (UINT32)pool;
+	}
+
+	service_error_check(S_MEMPOOL_CREATE, status);
+
+	return status;
+}
+
+// Same as mempool_create(), in the caller's storage (MEMPOOL_MEM_DEFINE).
+STATUS mempool_init(MEMPOOL *pool, void *mem, UINT32 block_size, UINT32 count, UINT32 *mpid)
+{
+	STATUS status = E_OK;
+
+	if ((pool == NULL) || (block_size == 0) || ((mem == NULL) && (count != 0)) ||
+	    ((UINT32)mem & (MEMPOOL_ALIGN - 1)))
+	{
+		status = E_MEMPOOL_INVALID;
+	}
+	else
+	{
+		os_mempool_setup(pool, mem, block_size, count, TRUE);
+
+		*mpid = (UINT32)pool;
+	}
+
+	service_error_check(S_MEMPOOL_INIT, status);
+
+	return status;
+}
+
+STATUS mempool_destroy(UINT32 mpid)
+{
+	STATUS status = E_OK;
+	MEMPOOL *pool = (MEMPOOL *)mpid;
+
+	if (pool == NULL)
+	{
+		status = E_MEMPOOL_INVALID;
+	}
+	else if (pool->used != 0)
+	{
+		status = E_OS_PERMISSION;	/* blocks are still in use */
+	}
+	else
+	{
+		os_sched_lock();
+
+		if (!pool->is_static)
+		{
+			nos_free(pool->mem);
+			nos_free(pool);
+		}
+
+		os_sched_unlock();
+	}
+
+	service_error_check(S_MEMPOOL_DESTROY, status);
+
+	return status;
+}
+
+// The pool grows into mem once its own blocks are all in use.
+STATUS mempool_set_backing(UINT32 mpid, void *mem, UINT32 bytes)
+{
+	STATUS status = E_OK;
+	MEMPOOL *pool = (MEMPOOL *)mpid;
+
+	if ((pool == NULL) || (mem == NULL) || ((UINT32)mem & (MEMPOOL_ALIGN - 1)) || (pool->backing != NULL))
+	{
+		status = E_MEMPOOL_INVALID;
+	}
+	else
+	{
+		os_sched_lock();
+
+		pool->backing = mem;
+		pool->backing_end = pool->backing + bytes - bytes % pool->block_size;
+
+		os_sched_unlock();
+	}
+
+	service_error_check(S_MEMPOOL_SET_BACKING, status);
+
+	return status;
+}
+
+// It can be called in ISR mode.
+void *mempool_alloc(UINT32 mpid)
+{
+	MEMPOOL *pool = (MEMPOOL *)mpid;
+	UINT8 *block = NULL;
+
+	os_sched_lock();
+
+	if (pool->free_list != NULL)
+	{
+		block = pool->free_list;
+		pool->free_list = *(void **)block;
+	}
+	else
+	{
+		if ((pool->next == pool->end) && (pool->end == pool->mem_end) && (pool->backing != NULL))
+		{
+			/* grow into the backing region */
+			pool->next = pool->backing;
+			pool->end = pool->backing_end;
+		}
+		if (pool->next != pool->end)
+		{
+			block = pool->next;
+			pool->next += pool->block_size;
+			if (pool->end == pool->backing_end)
+			{
+				pool->grown++;
+			}
+		}
+	}
+
+	if (block != NULL)
+	{
+		pool->alloc_count++;
+		if (++pool->used > pool->max_used)
+		{
+			pool->max_used = pool->used;
+		}
+	}
+	else
+	{
+		pool->alloc_fail++;
+	}
+
+	os_sched_unlock();
+
+	return block;
+}
+
+BOOL mempool_owns(UINT32 mpid, void *block)
+{
+	MEMPOOL *pool = (MEMPOOL *)mpid;
+	UINT8 *p = block;
+
+	if ((p >= pool->mem) && (p < pool->mem_end))
+	{
+		return ((UINT32)(p - pool->mem) % pool->block_size) == 0;
+	}
+	if ((p >= pool->backing) && (p < pool->backing_end))
+	{
+		return ((UINT32)(p - pool->backing) % pool->block_size) == 0;
+	}
+	return FALSE;
+}
+
+// It can be called in ISR mode.
+STATUS mempool_free(UINT32 mpid, void *block)
+{
+	STATUS status = E_OK;
+	MEMPOOL *pool = (MEMPOOL *)mpid;
+
+	if ((pool == NULL) || !mempool_owns(mpid, block))
+	{
+		status = E_MEMPOOL_INVALID;	/* not a block of this pool */
+	}
+	else
+	{
+		os_sched_lock();
+
+		*(void **)block = pool->free_list;
+		pool->free_list = block;
+		pool->used--;
+
+		os_sched_unlock();
+	}
+
+	service_error_check(S_MEMPOOL_FREE, status);
+
+	return status;
+}
+
+void mempool_get_stats(UINT32 mpid, MEMPOOL_STATS *stats)
+{
+	MEMPOOL *pool = (MEMPOOL *)mpid;
+
+	os_sched_lock();
+
+	stats->block_size = pool->block_size;
+	stats->capacity = (UINT32)((pool->mem_end - pool->mem) + (pool->backing_end - pool->backing)) / pool->block_size;
+	stats->used = pool->used;
+	stats->max_used = pool->max_used;
+	stats->alloc_count = pool->alloc_count;
+	stats->alloc_fail = pool->alloc_fail;
+	stats->grown = pool->grown;
+
+	os_sched_unlock();
+}
+
+#ifdef HEAP_CCM_THREADS
+void *os_thread_malloc(UINT32 len)
+{
+	void *mem = nos_malloc_region(MEM_CCM, len);
+
+	return (mem != NULL) ? mem : nos_malloc(len);
+}
+#endif
+
+#ifdef MEMPOOL_KOBJ
+
+static MEMPOOL_MEM_DEFINE(os_kobj_thread_mem, sizeof(struct _tcb), CONFIG_MEMPOOL_KOBJ_COUNT) OS_THREAD_MEM_ATTR;
+static MEMPOOL_MEM_DEFINE(os_kobj_alarm_mem, sizeof(struct _alarm), CONFIG_MEMPOOL_KOBJ_COUNT);
+static MEMPOOL_MEM_DEFINE(os_kobj_mutex_mem, sizeof(struct _mutex), CONFIG_MEMPOOL_KOBJ_COUNT);
+#ifdef SEM_M
+static MEMPOOL_MEM_DEFINE(os_kobj_sem_mem, sizeof(struct _sem), CONFIG_MEMPOOL_KOBJ_COUNT);
+#endif
+static MEMPOOL_MEM_DEFINE(os_kobj_msgq_mem, sizeof(struct _msgq), CONFIG_MEMPOOL_KOBJ_COUNT);
+static MEMPOOL_MEM_DEFINE(os_kobj_event_group_mem, sizeof(struct _event_group), CONFIG_MEMPOOL_KOBJ_COUNT);
+
+static MEMPOOL os_kobj_pool[KOBJ_TYPES] =
+{
+	[KOBJ_THREAD] = MEMPOOL_INITIALIZER(os_kobj_thread_mem, sizeof(struct _tcb)),
+	[KOBJ_ALARM] = MEMPOOL_INITIALIZER(os_kobj_alarm_mem, sizeof(struct _alarm)),
+	[KOBJ_MUTEX] = MEMPOOL_INITIALIZER(os_kobj_mutex_mem, sizeof(struct _mutex)),
+#ifdef SEM_M
+	[KOBJ_SEM] = MEMPOOL_INITIALIZER(os_kobj_sem_mem, sizeof(struct _sem)),
+#endif
+	[KOBJ_MSGQ] = MEMPOOL_INITIALIZER(os_kobj_msgq_mem, sizeof(struct _msgq)),
+	[KOBJ_EVENT_GROUP] = MEMPOOL_INITIALIZER(os_kobj_event_group_mem, sizeof(struct _event_group)),
+};
+
+// from the pool of the type, from the heap if it is empty
+void *os_kobj_alloc(UINT32 type, UINT32 size)
+{
+	void *obj = mempool_alloc((UINT32)&os_kobj_pool[type]);
+
+	if (obj == NULL)
+	{
+		obj = (type == KOBJ_THREAD) ? os_thread_malloc(size) : nos_malloc(size);
+	}
+	return obj;
+}
+
+void os_kobj_free(UINT32 type, void *obj)
+{
+	if (mempool_owns((UINT32)&os_kobj_pool[type], obj))
+	{
+		mempool_free((UINT32)&os_kobj_pool[type], obj);
+	}
+	else
+	{
+		nos_free(obj);
+	}
+}
+
+// for mempool_get_stats()
+UINT32 mempool_kobj_id(UINT32 type)
+{
+	return (UINT32)&os_kobj_pool[type];
+}
+
+#endif // MEMPOOL_KOBJ
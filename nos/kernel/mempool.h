@@ -0,0 +1,117 @@
+//===================================================================
+//
+// mempool.h
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+#ifndef MEMPOOL_H
+#define MEMPOOL_H
+#include "kconf.h"
+#include "nos_common.h"
+#include "heap.h"
+
+/*
+ * Fixed-block memory pools. A free block is linked through its own first
+ * word, so a block costs no header and mempool_alloc()/mempool_free() are
+ * a few pointer moves under the scheduler lock; both can be called in ISR
+ * mode. Blocks are cut from the pool memory on first use, so creation is
+ * O(1) as well and a pool can be initialized statically.
+ *
+ * A pool may be given a backing region (mempool_set_backing()): once its
+ * own blocks are all in use, further blocks are cut from the region, so
+ * the pool grows up to the region size without a heap call.
+ */
+
+#define MEMPOOL_ALIGN		8
+#define MEMPOOL_BLOCK_SIZE(size) \
+	((((size) < sizeof(void *) ? sizeof(void *) : (size)) + MEMPOOL_ALIGN - 1) & ~(MEMPOOL_ALIGN - 1))
+
+// memory of mempool_init(): count blocks of block_size bytes
+#define MEMPOOL_MEM_DEFINE(name, block_size, count) \
+	UINT8 name[MEMPOOL_BLOCK_SIZE(block_size) * (count)] __attribute__((aligned(MEMPOOL_ALIGN)))
+
+typedef struct _mempool
+{
+	void	*free_list;		// freed blocks
+	UINT8	*next, *end;		// blocks never used yet
+	UINT32	block_size;
+	UINT8	*mem, *mem_end;		// blocks of the pool
+	UINT8	*backing, *backing_end;	// blocks it may grow into
+	UINT32	used;
+	UINT32	max_used;
+	UINT32	alloc_count;
+	UINT32	alloc_fail;
+	UINT32	grown;			// blocks cut from the backing region
+	BOOL	is_static;		// from mempool_init(), not freed by mempool_destroy()
+} MEMPOOL;
+
+// a pool over the array area (MEMPOOL_MEM_DEFINE), without mempool_init()
+#define MEMPOOL_INITIALIZER(area, size) \
+	{ .next = (area), .end = (area) + sizeof(area), .block_size = MEMPOOL_BLOCK_SIZE(size), \
+	  .mem = (area), .mem_end = (area) + sizeof(area), .is_static = TRUE }
+
+typedef struct _mempool_stats
+{
+	UINT32	block_size;
+	UINT32	capacity;		// blocks, the backing region included
+	UINT32	used;
+	UINT32	max_used;
+	UINT32	alloc_count;
+	UINT32	alloc_fail;
+	UINT32	grown;
+} MEMPOOL_STATS;
+
+UINT32 mempool_create(UINT32 block_size, UINT32 count, UINT32 *mpid);
+UINT32 mempool_init(MEMPOOL *pool, void *mem, UINT32 block_size, UINT32 count, UINT32 *mpid);
+UINT32 mempool_destroy(UINT32 mpid);
+UINT32 mempool_set_backing(UINT32 mpid, void *mem, UINT32 bytes);
+void *mempool_alloc(UINT32 mpid);
+UINT32 mempool_free(UINT32 mpid, void *block);
+BOOL mempool_owns(UINT32 mpid, void *block);
+void mempool_get_stats(UINT32 mpid, MEMPOOL_STATS *stats);
+
+/*
+ * With MEMPOOL_KOBJ the kernel objects below are taken from a dedicated
+ * pool of CONFIG_MEMPOOL_KOBJ_COUNT blocks per type instead of the heap.
+ * When a pool is empty the heap is used.
+ */
+enum
+{
+	KOBJ_THREAD,
+	KOBJ_ALARM,
+	KOBJ_MUTEX,
+	KOBJ_SEM,
+	KOBJ_MSGQ,
+	KOBJ_EVENT_GROUP,
+	KOBJ_TYPES
+};
+
+/*
+ * With HEAP_CCM_THREADS thread stacks and TCBs come from the CCM heap, and
+ * from the main SRAM once it is full; OS_THREAD_MEM_ATTR puts static stacks
+ * in CCM as well (not zeroed at startup).
+ */
+#ifdef HEAP_CCM_THREADS
+#define OS_THREAD_MEM_ATTR	MEM_CCM_ATTR
+
+void *os_thread_malloc(UINT32 len);
+#else
+#define OS_THREAD_MEM_ATTR
+#define os_thread_malloc(len)	nos_malloc(len)
+#endif
+
+#ifdef MEMPOOL_KOBJ
+#ifndef CONFIG_MEMPOOL_KOBJ_COUNT
+#define CONFIG_MEMPOOL_KOBJ_COUNT	8
+#endif
+
+void *os_kobj_alloc(UINT32 type, UINT32 size);
+void os_kobj_free(UINT32 type, void *obj);
+UINT32 mempool_kobj_id(UINT32 type);
+#else
+#define os_kobj_alloc(type, size)	(((type) == KOBJ_THREAD) ? os_thread_malloc(size) : nos_malloc(size))
+#define os_kobj_free(type, obj)		nos_free(obj)
+#endif
+
+#endif // ~MEMPOOL_H
@@ -0,0 +1,226 @@
+//===================================================================
+//
+// msgpool.c
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+
+#include "msgpool.h"
+
+#include "heap.h"
+#include "critical_section.h"
+#include "sched.h"
+#include "msgq.h"
+#include "error.h"
+
+#define MSGBUF_STRIDE(pool)	MSGBUF_STRIDE_SIZE((pool)->buf_size)
+
+/* threads every buffer of mem on the free list */
+static void os_msgpool_setup(MSGPOOL *pool, void *mem, UINT32 buf_size, UINT32 count, BOOL is_static)
+{
+	MSGBUF *hdr;
+	UINT32 i;
+
+	pool->buf_size = buf_size;
+	pool->count = count;
+	pool->mem = mem;
+	pool->is_static = is_static;
+
+	pool->free_list = NULL;
+	for (i = count; i > 0; i--)
+	{
+		hdr = (MSGBUF *)(pool->mem + (i - 1) * MSGBUF_STRIDE(pool));
+		hdr->pool = pool;
+		hdr->next = pool->free_list;
+		pool->free_list = hdr;
+	}
+	pool->nfree = count;
+	pool->min_free = count;
+	pool->alloc_fail = 0;
+}
+
+STATUS msgpool_create(UINT32 buf_size, UINT32 count, UINT32 *poolid)
+{
+	STATUS status = E_OK;
+	MSGPOOL *pool;
+	void *mem;
+
+	if ((buf_size == 0) || (count == 0))
+	{
+		status = E_MSGPOOL_INVALID;
+	}
+	else if ((pool = nos_malloc(sizeof(struct _msgpool))) == NULL)
+	{
+		status = E_SYS_MEMORY;
+	}
+	else if ((mem = nos_malloc(MSGBUF_STRIDE_SIZE(buf_size) * count)) == NULL)
+	{
+		nos_free(pool);
+		status = E_SYS_MEMORY;
+	}
+	else
+	{
+		os_msgpool_setup(pool, mem, buf_size, count, FALSE);
+
+		*poolid = (UINT32)pool;
+	}
+
+	service_error_check(S_MSGPOOL_CREATE, status);
+
+	return status;
+}
+
+// Same as msgpool_create(), in the caller's storage (MSGPOOL_MEM_DEFINE).
+STATUS msgpool_init(MSGPOOL *pool, void *mem, UINT32 buf_size, UINT32 count, UINT32 *poolid)
+{
+	STATUS status = E_OK;
+
+	if ((pool == NULL) || (mem == NULL) || (buf_size == 0) || (count == 0))
+	{
+		status = E_MSGPOOL_INVALID;
+	}
+	else
+	{
+		os_msgpool_setup(pool, mem, buf_size, count, TRUE);
+
+		*poolid = (UINT32)pool;
+	}
+
+	service_error_check(S_MSGPOOL_INIT, status);
+
+	return status;
+}
+
+STATUS msgpool_destroy(UINT32 poolid)
+{
+	STATUS status = E_OK;
+	MSGPOOL *pool = (MSGPOOL *)poolid;
+
+	if (pool == NULL)
+	{
+		status = E_MSGPOOL_INVALID;
+	}
+	else if (pool->nfree != pool->count)
+	{
+		status = E_OS_PERMISSION;	/* buffers are still in use */
+	}
+	else
+	{
+		os_sched_lock();
+
+		if (!pool->is_static)
+		{
+			nos_free(pool->mem);
+			nos_free(pool);
+		}
+
+		os_sched_unlock();
+	}
+
+	service_error_check(S_MSGPOOL_DESTROY, status);
+
+	return status;
+}
+
+// It can be called in ISR mode. Returns NULL if the pool is empty.
+void *msgbuf_alloc(UINT32 poolid)
+{
+	MSGPOOL *pool = (MSGPOOL *)poolid;
+	MSGBUF *hdr;
+
+	os_sched_lock();
+
+	if ((hdr = pool->free_list) != NULL)
+	{
+		pool->free_list = hdr->next;
+		hdr->next = MSGBUF_IN_USE;
+
+		if (--pool->nfree < pool->min_free)
+		{
+			pool->min_free = pool->nfree;
+		}
+	}
+	else
+	{
+		pool->alloc_fail++;
+	}
+
+	os_sched_unlock();
+
+	return hdr ? (void *)(hdr + 1) : NULL;
+}
+
+// It can be called in ISR mode.
+STATUS msgbuf_free(void *buf)
+{
+	STATUS status = E_OK;
+	MSGBUF *hdr = (MSGBUF *)buf - 1;
+	MSGPOOL *pool;
+
+	if ((buf == NULL) || (hdr->next != MSGBUF_IN_USE))
+	{
+		status = E_MSGPOOL_BUF;	/* not a pool buffer, or freed twice */
+	}
+	else
+	{
+		pool = hdr->pool;
+
+		os_sched_lock();
+
+		hdr->next = pool->free_list;
+		pool->free_list = hdr;
+		pool->nfree++;
+
+		os_sched_unlock();
+	}
+
+	service_error_check(S_MSGBUF_FREE, status);
+
+	return status;
+}
+
+/*
+ * The ownership of buf goes to the receiver; on E_MSGQ_FULL or E_TIMEOUT it
+ * stays with the caller. A queue of messages longer than 1 word is
+ * refused (E_MSGQ_INVALID): it would copy past the pointer.
+ */
+STATUS msgq_send_buf(UINT32 mqid, void *buf, UINT32 timeout)
+{
+	STATUS status;
+	UINT32 msg = (UINT32)buf;
+
+	if ((mqid != 0) && (((MSGQ *)mqid)->msg_words != 1))
+	{
+		status = E_MSGQ_INVALID;
+		service_error_check(S_MSGQ_SEND, status);
+	}
+	else
+	{
+		status = msgq_send_timeout(mqid, &msg, timeout);
+	}
+
+	return status;
+}
+
+STATUS msgq_recv_buf(UINT32 mqid, void **buf, UINT32 timeout)
+{
+	STATUS status;
+	UINT32 msg;
+
+	if ((mqid != 0) && (((MSGQ *)mqid)->msg_words != 1))
+	{
+		status = E_MSGQ_INVALID;
+		service_error_check(S_MSGQ_RECV, status);
+	}
+	else
+	{
+		status = msgq_recv_timeout(mqid, &msg, timeout);
+		if (status == E_OK)
+		{
+			*buf = (void *)msg;
+		}
+	}
+
+	return status;
+}
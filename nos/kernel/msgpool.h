@@ -0,0 +1,61 @@
+//===================================================================
+//
+// msgpool.h
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+#ifndef MSGPOOL_H
+#define MSGPOOL_H
+#include "kconf.h"
+#include "nos_common.h"
+
+/*
+ * Zero-copy messages. A pool holds count buffers of buf_size bytes, taken
+ * from the heap once by msgpool_create(). The sender takes a buffer with
+ * msgbuf_alloc(), fills it in and passes the pointer through a (1-word)
+ * message queue with msgq_send_buf(); the receiver owns it after
+ * msgq_recv_buf() and gives it back with msgbuf_free(). Allocation and free
+ * are O(1) and can be called from ISRs.
+ */
+typedef struct _msgbuf
+{
+	struct _msgbuf	*next;		// free list link, MSGBUF_IN_USE while allocated
+	struct _msgpool	*pool;
+} MSGBUF;				// header in front of every buffer
+
+typedef struct _msgpool
+{
+	UINT32	buf_size;		// payload bytes of a buffer
+	UINT32	count;			// number of buffers
+	UINT32	nfree;			// buffers in the free list
+	UINT32	min_free;		// low watermark of nfree
+	UINT32	alloc_fail;		// msgbuf_alloc() calls that found the pool empty
+	MSGBUF	*free_list;
+	UINT8	*mem;
+	BOOL	is_static;		// from msgpool_init(), not freed by msgpool_destroy()
+} MSGPOOL;
+
+/* buffers are word aligned, the header included */
+#define MSGBUF_ALIGN(x)		(((x) + sizeof(UINT32) - 1) & ~(sizeof(UINT32) - 1))
+#define MSGBUF_STRIDE_SIZE(buf_size)	(sizeof(MSGBUF) + MSGBUF_ALIGN(buf_size))
+
+// memory of msgpool_init(): count buffers of buf_size bytes
+#define MSGPOOL_MEM_DEFINE(name, buf_size, count) \
+	UINT32 name[MSGBUF_STRIDE_SIZE(buf_size) * (count) / sizeof(UINT32)]
+
+#define MSGBUF_IN_USE	((MSGBUF *)1)
+
+UINT32 msgpool_create(UINT32 buf_size, UINT32 count, UINT32 *poolid);
+UINT32 msgpool_init(MSGPOOL *pool, void *mem, UINT32 buf_size, UINT32 count, UINT32 *poolid);
+UINT32 msgpool_destroy(UINT32 poolid);
+void *msgbuf_alloc(UINT32 poolid);
+UINT32 msgbuf_free(void *buf);
+
+UINT32 msgq_send_buf(UINT32 mqid, void *buf, UINT32 timeout);
+UINT32 msgq_recv_buf(UINT32 mqid, void **buf, UINT32 timeout);
+
+#define msgpool_get_free(poolid)	(((MSGPOOL *)(poolid))->nfree)
+#define msgpool_get_min_free(poolid)	(((MSGPOOL *)(poolid))->min_free)
+
+#endif // ~MSGPOOL_H
@@ -9,31 +9,121 @@
 #include "msgq.h"
 
 #include "heap.h"
+#include "mempool.h"
 #include "critical_section.h"
 #include "thread.h"
 #include "sched.h"
+#include "queue_thread.h"
 #include "error.h"
 
-STATUS msgq_create(UINT32 length, UINT32 *mqid)
+static void msgq_copy(UINT32 *dst, UINT32 *src, UINT32 words)
 {
-	STATUS status = E_OK;
-	MSGQ *msgq;
+	while (words--)
+	{
+		*dst++ = *src++;
+	}
+}
 
-	msgq = nos_malloc(sizeof(struct _msgq));
+/* puts a message at the rear of the ring, which has room */
+static void msgq_put(MSGQ *msgq, UINT32 *data)
+{
+	msgq_copy(msgq->queue + msgq->rear * msgq->msg_words, data, msgq->msg_words);
+	msgq->rear = (msgq->rear + 1) & msgq->mask;
+	++msgq->nitem;
+}
 
+/* takes the message at the front of the ring, which is not empty */
+static void msgq_get(MSGQ *msgq, UINT32 *data)
+{
+	msgq_copy(data, msgq->queue + msgq->front * msgq->msg_words, msgq->msg_words);
+	msgq->front = (msgq->front + 1) & msgq->mask;
+	--msgq->nitem;
+}
+
+static void os_msgq_setup(MSGQ *msgq, UINT32 *buffer, UINT32 length, UINT32 msg_words, BOOL is_static)
+{
 	msgq->length = length;
+	msgq->mask   = MSGQ_SLOTS(length) - 1;
+	msgq->msg_words = msg_words;
 	msgq->front  = 0;
 	msgq->rear   = 0;
 	msgq->nitem  = 0;
-	msgq->queue = nos_malloc(sizeof(UINT32)*length);
-	
-	*mqid = (UINT32)msgq;
+	msgq->queue  = buffer;
+	msgq->is_static = is_static;
+	init_tqueue(&msgq->send_wait);
+	init_tqueue(&msgq->recv_wait);
+#ifdef CORO_M
+	coro_waitq_init(&msgq->coro_wait);
+#endif
+}
+
+STATUS msgq_create_ex(UINT32 length, UINT32 msg_words, UINT32 *mqid)
+{
+	STATUS status = E_OK;
+	MSGQ *msgq;
+	UINT32 *buffer;
+
+	if ((length == 0) || (msg_words == 0))
+	{
+		status = E_MSGQ_CREATE;
+	}
+	else if ((msgq = os_kobj_alloc(KOBJ_MSGQ, sizeof(struct _msgq))) == NULL)
+	{
+		status = E_SYS_MEMORY;
+	}
+	else
+	{
+		buffer = nos_malloc(sizeof(UINT32) * MSGQ_SLOTS(length) * msg_words);
+
+		if (buffer == NULL)
+		{
+			os_kobj_free(KOBJ_MSGQ, msgq);
+			status = E_SYS_MEMORY;
+		}
+		else
+		{
+			os_msgq_setup(msgq, buffer, length, msg_words, FALSE);
+			*mqid = (UINT32)msgq;
+		}
+	}
 
 	service_error_check(S_MSGQ_CREATE, status);
 
 	return status;
 }
 
+/*
+ * Same as msgq_create_ex(), in the caller's storage: buffer holds
+ * MSGQ_SLOTS(length) messages (MSGQ_BUFFER_DEFINE).
+ */
+STATUS msgq_init(MSGQ *msgq, UINT32 *buffer, UINT32 length, UINT32 msg_words, UINT32 *mqid)
+{
+	STATUS status = E_OK;
+
+	if ((msgq == NULL) || (buffer == NULL))
+	{
+		status = E_MSGQ_INVALID;
+	}
+	else if ((length == 0) || (msg_words == 0))
+	{
+		status = E_MSGQ_CREATE;
+	}
+	else
+	{
+		os_msgq_setup(msgq, buffer, length, msg_words, TRUE);
+		*mqid = (UINT32)msgq;
+	}
+
+	service_error_check(S_MSGQ_INIT, status);
+
+	return status;
+}
+
+STATUS msgq_create(UINT32 length, UINT32 *mqid)
+{
+	return msgq_create_ex(length, 1, mqid);
+}
+
 STATUS msgq_destroy(UINT32 mqid)
 {
     STATUS status = E_OK;
@@ -43,11 +133,19 @@ STATUS msgq_destroy(UINT32 mqid)
 	{		
         status = E_MSGQ_INVALID;
 	}
+    else if ((msgq->send_wait.head != NULL) || (msgq->recv_wait.head != NULL))
+    {
+        status = E_OS_PERMISSION;	/* threads are waiting for it */
+    }
     else
     {
         os_sched_lock();
 		
-        nos_free(msgq);
+        if (!msgq->is_static)
+        {
+            nos_free(msgq->queue);
+            os_kobj_free(KOBJ_MSGQ, msgq);
+        }
 
         os_sched_unlock();
     }
@@ -57,31 +155,62 @@ STATUS msgq_destroy(UINT32 mqid)
     return status;
 }
 
-STATUS msgq_send(UINT32 mqid, UINT32 *data)
+// With timeout 0, it can be called in ISR mode.
+STATUS msgq_send_timeout(UINT32 mqid, UINT32 *data, UINT32 timeout)
 {
 	STATUS status = E_OK;
 	MSGQ *msgq = (MSGQ *)mqid;
+	THREAD *thread;
 
     if (msgq == NULL)
 	{
         status = E_MSGQ_INVALID;
 	}
-	else if (msgq->nitem == msgq->length)
+	else if ((timeout != 0) && NOS_IS_ISR_MODE())
 	{
-		 status = E_MSGQ_FULL;
-
-		 return status;
+		status = E_OS_PERMISSION;
 	}
 	else  /* send a message into queue */
 	{
 		os_sched_lock();
 
-		/* copy the data into kernel memory region */
-		*(msgq->queue + msgq->rear) = *data;
-		++msgq->nitem;
-		msgq->rear = (msgq->rear+1)%msgq->length;
-	
-		os_sched_unlock();
+		if ((thread = pop_tnode(&msgq->recv_wait)) != NULL)
+		{
+			/* the ring is empty: hand the message to the receiver */
+			msgq_copy(thread->wait_buf, data, msgq->msg_words);
+			os_wait_wakeup(thread);
+
+			os_sched_unlock_switch();
+		}
+		else if (msgq->nitem < msgq->length)
+		{
+			/* copy the data into kernel memory region */
+			msgq_put(msgq, data);
+
+			os_sched_unlock();
+#ifdef CORO_M
+			coro_waitq_wake(&msgq->coro_wait);
+#endif
+		}
+		else if (timeout == 0)
+		{
+			os_sched_unlock();
+
+			return E_MSGQ_FULL;
+		}
+		else
+		{
+			/* the receiver that makes room puts our message in the ring */
+			current_thread->wait_buf = data;
+			os_wait_block(&msgq->send_wait, timeout);
+
+			os_sched_unlock_switch();
+
+			if (current_thread->wait_status != E_OK)
+			{
+				return current_thread->wait_status;
+			}
+		}
 	}
 	
 	service_error_check(S_MSGQ_SEND, status);
@@ -89,33 +218,73 @@ STATUS msgq_send(UINT32 mqid, UINT32 *data)
 	return status;
 }
 
-STATUS msgq_recv(UINT32 mqid, UINT32 *data)
+// With timeout 0, it can be called in ISR mode.
+STATUS msgq_recv_timeout(UINT32 mqid, UINT32 *data, UINT32 timeout)
 {
 	STATUS status = E_OK;
 	MSGQ *msgq = (MSGQ *)mqid;
+	THREAD *thread;
 
     if (msgq == NULL)
 	{
     	status = E_MSGQ_INVALID;
 	}
-	else if (msgq->nitem == 0)
+	else if ((timeout != 0) && NOS_IS_ISR_MODE())
 	{
-		status = E_MSGQ_EMPTY;
-		return status;
+		status = E_OS_PERMISSION;
 	}
 	else
 	{
 		os_sched_lock();
 
-		*data = *(msgq->queue + msgq->front);
+		if (msgq->nitem > 0)
+		{
+			msgq_get(msgq, data);
+
+			/* a sender waits for the room we made */
+			if ((thread = pop_tnode(&msgq->send_wait)) != NULL)
+			{
+				msgq_put(msgq, thread->wait_buf);
+				os_wait_wakeup(thread);
+			}
+
+			os_sched_unlock_switch();
+#ifdef CORO_M
+			coro_waitq_wake(&msgq->coro_wait);	/* room for a sender */
+#endif
+		}
+		else if (timeout == 0)
+		{
+			os_sched_unlock();
+
+			return E_MSGQ_EMPTY;
+		}
+		else
+		{
+			/* the next sender copies its message into data */
+			current_thread->wait_buf = data;
+			os_wait_block(&msgq->recv_wait, timeout);
 
-		msgq->front = (msgq->front+1)%msgq->length;
-		--msgq->nitem;
+			os_sched_unlock_switch();
 
-		os_sched_unlock();
+			if (current_thread->wait_status != E_OK)
+			{
+				return current_thread->wait_status;
+			}
+		}
 	}
 
 	service_error_check(S_MSGQ_RECV, status);
 
 	return status;
 } 
+
+STATUS msgq_send(UINT32 mqid, UINT32 *data)
+{
+	return msgq_send_timeout(mqid, data, 0);
+}
+
+STATUS msgq_recv(UINT32 mqid, UINT32 *data)
+{
+	return msgq_recv_timeout(mqid, data, 0);
+}
@@ -9,21 +9,55 @@
 #define MSGQ_H
 #include "kconf.h"
 #include "nos_common.h"
+#include "queue_thread.h"
+#include "coro.h"
 
+/*
+ * A ring of fixed-size messages (msg_words UINT32 words each) stored inline.
+ * The ring has a power of two of slots, the length rounded up, so that its
+ * indexes wrap with a mask; the queue still holds length messages at most.
+ * msgq_send_timeout() and msgq_recv_timeout() sleep the caller in a wait
+ * list of the queue; a blocked receiver gets the message straight from the
+ * sender, and a blocked sender is put in the ring by the receiver that
+ * makes room.
+ */
 typedef struct _msgq
 {
-	 UINT32 length; 		// length of queue
+	 UINT32 length; 		// length of queue (messages)
+	 UINT32 mask;			// slots of the ring (a power of two) - 1
+	 UINT32 msg_words;		// size of a message (UINT32 words)
 	 UINT32 type;
 	 UINT32 front, rear, nitem; // front, rear of the queue, the number of items in the queue
 	 UINT32 *queue;
+	 TQUEUE send_wait;		// senders waiting for room
+	 TQUEUE recv_wait;		// receivers waiting for a message
+	 BOOL is_static;		// from msgq_init(), not freed by msgq_destroy()
+#ifdef CORO_M
+	 CORO_WAITQ coro_wait;		// coroutines waiting to send or receive
+#endif
 } MSGQ;
 
-#define MSGQ_IS_FULL(mq) (mq->nitem == mq->len)
+#define MSGQ_IS_FULL(mq) (mq->nitem == mq->length)
 #define MSGQ_IS_EMPTY(mq) (mq->nitem == 0)
 
+// slots of a queue of length messages: length rounded up to a power of two
+#define MSGQ_SLOTS(length)	(MSGQ_POW2_16(MSGQ_POW2_8(MSGQ_POW2_4(MSGQ_POW2_2(MSGQ_POW2_1((length) - 1))))) + 1)
+#define MSGQ_POW2_1(x)		((x) | (x) >> 1)
+#define MSGQ_POW2_2(x)		((x) | (x) >> 2)
+#define MSGQ_POW2_4(x)		((x) | (x) >> 4)
+#define MSGQ_POW2_8(x)		((x) | (x) >> 8)
+#define MSGQ_POW2_16(x)		((x) | (x) >> 16)
+
+// ring of msgq_init(): MSGQ_SLOTS(length) messages of msg_words words
+#define MSGQ_BUFFER_DEFINE(name, length, msg_words)	UINT32 name[MSGQ_SLOTS(length) * (msg_words)]
+
 UINT32 msgq_create(UINT32 length, UINT32 *mqid);
+UINT32 msgq_create_ex(UINT32 length, UINT32 msg_words, UINT32 *mqid);
+UINT32 msgq_init(MSGQ *msgq, UINT32 *buffer, UINT32 length, UINT32 msg_words, UINT32 *mqid);
 UINT32 msgq_destroy(UINT32 mqid);
 UINT32 msgq_send(UINT32 id, UINT32 *data);
 UINT32 msgq_recv(UINT32 id, UINT32 *data);
+UINT32 msgq_send_timeout(UINT32 id, UINT32 *data, UINT32 timeout);
+UINT32 msgq_recv_timeout(UINT32 id, UINT32 *data, UINT32 timeout);
 
 #endif // ~MSGQ_H
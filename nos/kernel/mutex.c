@@ -9,20 +9,142 @@
 #include "mutex.h"
 #include "critical_section.h"
 #include "heap.h"
+#include "mempool.h"
 #include "sched.h"
 #include "thread.h"
 #include "thread_table.h"
 #include "queue_thread.h"
 #include "error.h"
 
-//#define OFFSET_OF(TYPE, MEMBER) ((unsigned int)(&((TYPE *)0)->MEMBER))
+static void os_mutex_hold(MUTEX *mutex, THREAD *thread)
+{
+	mutex->owner = thread;
+	mutex->lock_level = 0;
+	mutex->next_held = thread->held_mutex;
+	thread->held_mutex = mutex;
+}
+
+static void os_mutex_release(MUTEX *mutex)
+{
+	MUTEX **pp;
+
+	for (pp = &mutex->owner->held_mutex; *pp != NULL; pp = &(*pp)->next_held)
+	{
+		if (*pp == mutex)
+		{
+			*pp = mutex->next_held;
+			break;
+		}
+	}
+
+	mutex->next_held = NULL;
+	mutex->owner = NULL;
+}
+
+/*
+ * Recomputes the priority of a thread from its own priority, the ceilings of
+ * the mutexes it holds and the highest waiter of each of them. If it changes
+ * and the thread itself waits for a mutex, the change goes on to that owner.
+ * The chain is walked at most once per thread, so a deadlock cycle ends too.
+ *
+ * With EDF_SCHED the deadline is inherited the same way: an owner takes the
+ * earliest deadline of the waiters at the EDF level, so that it is ordered
+ * among the EDF jobs by the deadline it blocks, and gets its own back when
+ * it releases the mutex.
+ */
+void os_mutex_priority_update(THREAD *thread)
+{
+	MUTEX *mutex;
+	UINT32 priority, hops;
+#ifdef EDF_SCHED
+	THREAD *waiter;
+	UINT64 deadline;
+#endif
+
+	for (hops = 0; (thread != NULL) && (hops < MAX_NUM_TOTAL_THREAD); hops++)
+	{
+		priority = thread->base_priority;
+#ifdef EDF_SCHED
+		deadline = thread->base_deadline;
+#endif
+
+		for (mutex = thread->held_mutex; mutex != NULL; mutex = mutex->next_held)
+		{
+			if (mutex->ceil_priority > priority)
+			{
+				priority = mutex->ceil_priority;
+			}
+			if ((mutex->wait_queue.head != NULL) && (mutex->wait_queue.head->priority > priority))
+			{
+				priority = mutex->wait_queue.head->priority;
+			}
+#ifdef EDF_SCHED
+			for (waiter = mutex->wait_queue.head; waiter != NULL; waiter = waiter->next)
+			{
+				if ((waiter->priority == CONFIG_EDF_PRIORITY) && (waiter->abs_deadline < deadline))
+				{
+					deadline = waiter->abs_deadline;
+				}
+			}
+#endif
+		}
+
+#ifdef EDF_SCHED
+		if ((priority == thread->priority) && (deadline == thread->abs_deadline))
+#else
+		if (priority == thread->priority)
+#endif
+		{
+			break;
+		}
+
+		if (thread->state == TS_READY)
+		{
+			os_qRemove(thread);
+			thread->priority = priority;
+#ifdef EDF_SCHED
+			thread->abs_deadline = deadline;
+#endif
+			os_qPush(thread);
+		}
+		else
+		{
+			thread->priority = priority;
+#ifdef EDF_SCHED
+			thread->abs_deadline = deadline;
+#endif
+		}
+
+		if ((mutex = thread->wait_mutex) == NULL)
+		{
+			break;
+		}
+
+		/* keep the wait queue ordered, then pass the change on to its owner */
+		delete_tnode(&mutex->wait_queue, thread);
+		push_tnode_prio(&mutex->wait_queue, thread);
+		thread = mutex->owner;
+	}
+}
+
+static void os_mutex_setup(MUTEX *mutex, UINT32 ceil_priority, BOOL is_static)
+{
+	/* if ceil_priority == 0, then ceiling priority protocol is not applied */
+	mutex->ceil_priority = ceil_priority; 
+	mutex->owner = NULL;
+	mutex->lock_level = 0;
+	mutex->next_held = NULL;
+	mutex->is_static = is_static;
+	
+	init_tqueue(&mutex->wait_queue);
+}
 
 STATUS mutex_create(UINT32 *muid, UINT32 ceil_priority)
 {
 	STATUS status = E_OK;
     MUTEX *mutex;
 
-	mutex = nos_malloc(sizeof(struct _mutex));
+	mutex = os_kobj_alloc(KOBJ_MUTEX, sizeof(struct _mutex));
 
 	if (mutex == NULL)
 	{
@@ -30,12 +152,7 @@ STATUS mutex_create(UINT32 *muid, UINT32 ceil_priority)
 	}
 	else
 	{
-		/* if ceil_priority == 0, then ceiling priority protocol is not applied */
-		mutex->ceil_priority = ceil_priority; 
-		mutex->owner = NULL;
-		mutex->lock_level = 0;
-		
-		init_tqueue(&mutex->wait_queue);
+		os_mutex_setup(mutex, ceil_priority, FALSE);
 
 		*muid = (UINT32)mutex;
 	}
@@ -45,6 +162,27 @@ STATUS mutex_create(UINT32 *muid, UINT32 ceil_priority)
     return status;
 }
 
+// Same as mutex_create(), in the caller's storage.
+STATUS mutex_init(MUTEX *mutex, UINT32 *muid, UINT32 ceil_priority)
+{
+	STATUS status = E_OK;
+
+	if (mutex == NULL)
+	{
+		status = E_MUTEX_INVALID;
+	}
+	else
+	{
+		os_mutex_setup(mutex, ceil_priority, TRUE);
+
+		*muid = (UINT32)mutex;
+	}
+
+	service_error_check(S_MUTEX_INIT, status);
+
+    return status;
+}
+
 STATUS mutex_destroy(UINT32 muid)
 {
     STATUS status = E_OK;
@@ -54,11 +192,18 @@ STATUS mutex_destroy(UINT32 muid)
    	{
         status = E_MUTEX_INVALID;
    	}
+    else if (mutex->owner != NULL)
+    {
+        status = E_MUTEX_OCCUPIED;
+    }
     else
     {
 		os_sched_lock();
 
-       	nos_free(mutex);
+		if (!mutex->is_static)
+		{
+       		os_kobj_free(KOBJ_MUTEX, mutex);
+		}
 
 		os_sched_unlock();
 	}
@@ -68,7 +213,7 @@ STATUS mutex_destroy(UINT32 muid)
         return status;
 }
 
-STATUS mutex_lock(UINT32 muid)
+STATUS mutex_lock_timeout(UINT32 muid, UINT32 timeout)
 {
     STATUS status = E_OK;
     MUTEX *mutex = (MUTEX *)muid;
@@ -86,18 +231,10 @@ STATUS mutex_lock(UINT32 muid)
 		os_sched_lock();
 		if (mutex->owner == NULL)
 		{
-			mutex->owner = current_thread;
+			os_mutex_hold(mutex, current_thread);
 
 			/* apply the priority ceiling protocol */
-			if (mutex->ceil_priority && (current_thread->priority < mutex->ceil_priority))
-			{
-				os_qRemove(current_thread);	
-				
-	        	mutex->saved_priority  = current_thread->priority;
-				current_thread->priority = mutex->ceil_priority; // Ceil the thread priority	
-									
-				os_qPush(current_thread);
-			}	
+			os_mutex_priority_update(current_thread);
 			
 			/* context switch is not needed */
 			os_sched_unlock();
@@ -108,15 +245,27 @@ STATUS mutex_lock(UINT32 muid)
 				
 			os_sched_unlock();
 		}
+		else if (timeout == 0)
+		{
+			os_sched_unlock();
+
+			return E_TIMEOUT;
+		}
 		else
 		{			
-			os_qRemove(current_thread);
-			
-			push_tnode(&mutex->wait_queue, current_thread);
-			
-			current_thread->state = TS_WAIT;
+			current_thread->wait_mutex = mutex;
+			os_wait_block(&mutex->wait_queue, timeout);
+
+			/* the owner (and whoever it waits for) inherits our priority */
+			os_mutex_priority_update(mutex->owner);
 
 			os_sched_unlock_switch();
+
+			/* the mutex was handed to us, or the wait timed out */
+			if (current_thread->wait_status != E_OK)
+			{
+				return current_thread->wait_status;
+			}
 		}
    	}
 
@@ -125,6 +274,11 @@ STATUS mutex_lock(UINT32 muid)
 	return status;
 }
 
+STATUS mutex_lock(UINT32 muid)
+{
+	return mutex_lock_timeout(muid, WAIT_FOREVER);
+}
+
 STATUS mutex_unlock(UINT32 muid)
 {
 
@@ -156,38 +310,26 @@ STATUS mutex_unlock(UINT32 muid)
 		}
 		else
 		{
-			//NODE *node;
 			THREAD *thread;
 			
-			/* apply the priority ceiling protocol */
-			if (mutex->ceil_priority && (current_thread->priority > mutex->saved_priority))
-			{
-				os_qRemove(current_thread);
-				
-				current_thread->priority = mutex->saved_priority;
-						
-				os_qPush(current_thread);
-			}
+			os_mutex_release(mutex);
 
-			//node = pop_node(&mutex->wait_queue);
+			/* hand the mutex over to the highest priority waiter */
 			thread = pop_tnode(&mutex->wait_queue);
 			
 			if (thread != NULL)
 			{
-				//THREAD *thread;
-
-				//thread = (THREAD *) ((UINT32)node - OFFSET_OF(_TCB, rdy_node));
-				mutex->owner = thread;
+				os_mutex_hold(mutex, thread);
 
 				/* wake up the popped thread */
-				os_qPush(thread);
+				os_wait_wakeup(thread);
 
-				thread->state = TS_READY;
-			}
-			else
-			{
-				mutex->owner = NULL;
+				/* it inherits from the remaining waiters */
+				os_mutex_priority_update(thread);
 			}
+
+			/* drop what we inherited through this mutex */
+			os_mutex_priority_update(current_thread);
 			
 			os_sched_unlock_switch();
 		}
@@ -197,4 +339,3 @@ STATUS mutex_unlock(UINT32 muid)
 
 	return status;
 }
-
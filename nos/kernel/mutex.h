@@ -13,20 +13,31 @@
 
 #include "nos_common.h"
 
+/*
+ * A thread that blocks on a mutex lends its priority to the owner, and on
+ * through the chain of mutexes the owner itself waits for (transitive
+ * priority inheritance). Waiters are queued by priority, and the lock is
+ * handed to the highest priority one.
+ */
 typedef struct _mutex
 {
 	UINT32	ceil_priority;
-	UINT32	saved_priority;
 	UINT32	lock_level;
 	THREAD  *owner;
-	TQUEUE  wait_queue;
+	TQUEUE  wait_queue;		// ordered by priority, FIFO among equals
+	struct _mutex *next_held;	// next mutex held by the owner
+	BOOL	is_static;		// from mutex_init(), not freed by mutex_destroy()
 } MUTEX;
 
 #define NO_CEILING	(0)
 
 UINT32 mutex_create(UINT32 *muid, UINT32 ceil_priority);
+UINT32 mutex_init(MUTEX *mutex, UINT32 *muid, UINT32 ceil_priority);
 UINT32 mutex_destroy(UINT32 muid);
 UINT32 mutex_lock(UINT32 muid);
+UINT32 mutex_lock_timeout(UINT32 muid, UINT32 timeout);
 UINT32 mutex_unlock(UINT32 muid);
 
+void os_mutex_priority_update(THREAD *thread);
+
 #endif // ~MUTEX_H
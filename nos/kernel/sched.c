@@ -9,6 +9,7 @@
 #include "sched.h"
 #include "hal_sched.h"	
 #include "heap.h"
+#include "mempool.h"
 #include "arch.h"
 #include "critical_section.h"
 #include "intr.h"
@@ -22,10 +23,16 @@
 #include "thread_table.h"
 #include "queue_thread.h"
 #include "tick.h"
+#include "alarm.h"
+#include "hrtimer.h"
 #include "pwmgmt.h"
 
 #include "lowpower.h"
 
+#if defined(ALARM_THREAD) && defined(EDF_SCHED) && (CONFIG_ALARM_THREAD_PRIORITY == CONFIG_EDF_PRIORITY)
+#error "CONFIG_ALARM_THREAD_PRIORITY and CONFIG_EDF_PRIORITY must differ: the timer thread would wait behind the EDF jobs"
+#endif
+
 /* extern variables */
 extern THREAD *highest_thread;
 extern void (*sched_callback)(void);   /* used for setting the scheduling handler */
@@ -34,15 +41,18 @@ extern void (*sched_callback)(void);   /* used for setting the scheduling handle
 extern void app_init(void);
 extern void mysystem_save(unsigned long);
 
-extern UINT32 Tick_Period;
-extern UINT32 Remain_Tick_Value;
-extern UINT32 SysTick_Reload_OverFlow;
 
 /* local variables */
 COUNT	os_sched_lock_level = 0;
+#ifdef THREAD_STATS
+BOOL	os_sched_yielding = FALSE;	/* the next switch is a thread_yield() */
+#endif
 THREAD *current_thread;
 THREAD *idle_thread;
 THREAD *super_thread;
+#ifdef ALARM_THREAD
+THREAD *alarm_thread;
+#endif
 EVENT_MASK super_event;
 
 void (*usr_init)(void) = app_init; /* usr app init function */
@@ -54,24 +64,128 @@ static void os_sched_callback(void (*func)(void));
 static void os_idle_task(void *args);
 static void os_super_task(void *args);
 static void display_kernel_info(void);
+static void os_rr_expired(UINT32 arg);
+
+static DNODE os_rr_dnode;	/* time slice of the running RR thread */
+
+/* the kernel threads are static: booting takes nothing from the heap for them */
+static THREAD os_idle_tcb, os_super_tcb;
+static THREAD_STACK_DEFINE(os_idle_stack, SYSTEM_STACK_SIZE) OS_THREAD_MEM_ATTR;
+static THREAD_STACK_DEFINE(os_super_stack, SYSTEM_STACK_SIZE) OS_THREAD_MEM_ATTR;
+#ifdef ALARM_THREAD
+static THREAD os_alarm_tcb;
+static THREAD_STACK_DEFINE(os_alarm_stack, SYSTEM_STACK_SIZE) OS_THREAD_MEM_ATTR;
+#endif
+
+#ifdef TICK_ISR_STATS
+static UINT32 os_tick_isr_max_us;	/* longest tick_q processing in the tick ISR */
+static UINT32 os_tick_isr_cnt;
+#endif
 
 
 
+/*
+ * Called at every context switch, with interrupts disabled, before
+ * current_thread becomes next. The time slice of a RR thread only runs while
+ * the thread is running, so the tick timer stays idle otherwise.
+ */
+void os_sched_switch_hook(THREAD *prev, THREAD *next)
+{
+#ifdef THREAD_STATS
+	if ((prev->state == TS_READY) && !os_sched_yielding)
+	{
+		prev->preempt_cnt++;	/* involuntary: preempted or sliced */
+	}
+	else
+	{
+		prev->switch_cnt++;
+	}
+	os_sched_yielding = FALSE;
+#endif
+
+	if (prev->option == RR)
+	{
+		tickq_Remove(&os_rr_dnode);
+	}
+	if (next->option == RR)
+	{
+		tickq_Push(&os_rr_dnode, next->quantum);
+	}
+}
+
+/* the time slice of current_thread is over (ISR mode) */
+static void os_rr_expired(UINT32 arg)
+{
+	THREAD *thread = current_thread;
+
+	if (thread->option != RR)
+	{
+		return;
+	}
+
+	if ((thread->state == TS_READY) && (os_rdy_q[thread->priority].head->next != NULL))
+	{
+		/* the next thread of the same priority gets the CPU on the way out of the ISR */
+		os_qRemove(thread);
+		os_qPush(thread);
+	}
+	else
+	{
+		/* no other ready thread of this priority, start a new slice */
+		tickq_Push(&os_rr_dnode, thread->quantum);
+	}
+}
+
 static void os_sched_handler(void)
 {
+#ifdef TICK_ISR_STATS
+	UINT64 start = os_time_get_us();
+	UINT32 elapsed;
+#endif
+
 	os_sched_lock_level++;
 
 	/*  tickq_Expired() will handle all housekeeping works. */
 	tickq_Expired(); 
 
 	os_sched_lock_level--;
+
+#ifdef TICK_ISR_STATS
+	elapsed = (UINT32)(os_time_get_us() - start);
+	if (elapsed > os_tick_isr_max_us)
+	{
+		os_tick_isr_max_us = elapsed;
+	}
+	os_tick_isr_cnt++;
+#endif
+}
+
+#ifdef TICK_ISR_STATS
+UINT32 get_tick_isr_max_us(void)
+{
+	return os_tick_isr_max_us;
+}
+
+UINT32 get_tick_isr_count(void)
+{
+	return os_tick_isr_cnt;
+}
+
+void reset_tick_isr_stats(void)
+{
+	os_tick_isr_max_us = 0;
+	os_tick_isr_cnt = 0;
 }
+#endif
 
 void os_sched_init(void)
 {
 	UINT32 i;
 	UINT32 super_tid;
 	UINT32 idle_tid;
+#ifdef ALARM_THREAD
+	UINT32 alarm_tid;
+#endif
 	
 	/* STEP1 : Setting of periodic scheduler interrupt */
 	nos_sched_hal_init();
@@ -86,17 +200,29 @@ void os_sched_init(void)
 	}
 
 	/* STEP4 : Prepare Idle THREAD */
-	thread_create(os_idle_task, NULL, 0, PRIORITY_IDLE_THREAD, FIFO, &idle_tid);
+	thread_init(&os_idle_tcb, os_idle_stack, sizeof(os_idle_stack), os_idle_task, NULL, PRIORITY_IDLE_THREAD, FIFO, &idle_tid);
 	idle_thread = (THREAD *)idle_tid;
 
 	/* STEP5 : Prepare Super thread */
-	thread_create(os_super_task, NULL, 0, PRIORITY_SUPER_THREAD, FIFO, &super_tid);
+	thread_init(&os_super_tcb, os_super_stack, sizeof(os_super_stack), os_super_task, NULL, PRIORITY_SUPER_THREAD, FIFO, &super_tid);
 	super_thread = (THREAD *)super_tid;
+
+#ifdef ALARM_THREAD
+	/* Timer thread running the alarm handlers */
+	thread_init(&os_alarm_tcb, os_alarm_stack, sizeof(os_alarm_stack), os_alarm_task, NULL, CONFIG_ALARM_THREAD_PRIORITY, FIFO, &alarm_tid);
+	alarm_thread = (THREAD *)alarm_tid;
+#endif
 		
 	display_kernel_info(); // added by @sheart 20101228
 
 	/* STEP6 : Initialize Tick queue */
 	tickq_Init();
+	init_dnode(&os_rr_dnode, os_rr_expired, 0);
+
+#ifdef HRTIMER_M
+	/* STEP7 : Start the high-resolution timer counter */
+	os_hrtimer_init();
+#endif
 	
 }
 
@@ -109,6 +235,12 @@ void os_start(void)
 	os_qPush(idle_thread);
 	idle_thread->state = TS_READY;	
 
+#ifdef ALARM_THREAD
+	/* the timer thread blocks until an alarm expires */
+	os_qPush(alarm_thread);
+	alarm_thread->state = TS_READY;
+#endif
+
 	/* launch the super thread and update the highest thread */	
 	/* push super thread to the ready queue */
 	os_qPush(super_thread);
@@ -136,6 +268,7 @@ void os_sched_unlock_switch(void)
 		{
 			THREAD *prev_thread = current_thread;
 			
+			os_sched_switch_hook(prev_thread, highest_thread);
 			current_thread = highest_thread;
 
 			os_sched_lock_level--;
@@ -147,8 +280,12 @@ void os_sched_unlock_switch(void)
 			NOS_EXIT_CRITICAL_SECTION();	
 		}
 	}
-	else
+	else /* ISR mode: switch on the way out of the interrupt */
 	{
+		if (highest_thread != current_thread)
+		{
+			NOS_CTX_SW_PENDING_SET();
+		}
 		NOS_EXIT_CRITICAL_SECTION();	
 	}
 }
@@ -161,6 +298,7 @@ void os_sched_unlock_bottom_half(void)
 		{
 			THREAD *prev_thread = current_thread;
 			
+			os_sched_switch_hook(prev_thread, highest_thread);
 			current_thread = highest_thread;
 
 			os_sched_lock_level--;
@@ -15,10 +15,16 @@
 
 // priority setting
 // LOWEST <<----------------->> HIGHEST
-//   0     			  255
+//   0     	  PRIORITY_LEVEL_COUNT-1
+#if defined PRIORITY_LEVELS_8
+#define PRIORITY_LEVEL_COUNT	8
+#elif defined PRIORITY_LEVELS_32
+#define PRIORITY_LEVEL_COUNT	32
+#else
 #define PRIORITY_LEVEL_COUNT	256 // 256 prorities available
+#endif
 
-#define PRIORITY_ULTRA		255  // reserved for the system thread
+#define PRIORITY_ULTRA		(PRIORITY_LEVEL_COUNT - 1)  // reserved for the system thread
 #define PRIORITY_HIGHEST	5//254	
 #define PRIORITY_HIGH		4//200
 #define PRIORITY_NORMAL		3//100
@@ -26,7 +32,7 @@
 #define PRIORITY_LOWEST		1   // reserved for the idle thread
 
 #define	PRIORITY_IDLE_THREAD	0
-#define	PRIORITY_SUPER_THREAD	255
+#define	PRIORITY_SUPER_THREAD	(PRIORITY_LEVEL_COUNT - 1)
 
 #define PRIORITY(N)		N
 
@@ -44,5 +50,13 @@ void os_sched_lock(void);
 void os_sched_unlock(void);
 void os_sched_unlock_switch(void);
 void os_sched_unlock_bottom_half(void);
+void os_sched_switch_hook(THREAD *prev, THREAD *next);
+
+#ifdef TICK_ISR_STATS
+/* time spent on tick_q expiries in the tick ISR, in microseconds */
+UINT32 get_tick_isr_max_us(void);
+UINT32 get_tick_isr_count(void);
+void reset_tick_isr_stats(void);
+#endif
 
 #endif // ~SCHED_H
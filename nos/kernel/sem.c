@@ -0,0 +1,205 @@
+//===================================================================
+//
+// sem.c
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+
+#include "sem.h"
+
+#ifdef SEM_M
+
+#include "critical_section.h"
+#include "heap.h"
+#include "mempool.h"
+#include "sched.h"
+#include "thread.h"
+#include "queue_thread.h"
+#include "error.h"
+
+static void os_sem_setup(SEM *sem, UINT32 init_count, UINT32 max_count, BOOL is_static)
+{
+	sem->count = init_count;
+	sem->max_count = max_count;
+	sem->is_static = is_static;
+	init_tqueue(&sem->wait_queue);
+}
+
+STATUS sem_create(UINT32 *semid, UINT32 init_count, UINT32 max_count)
+{
+	STATUS status = E_OK;
+	SEM *sem;
+
+	if ((max_count == 0) || (init_count > max_count))
+	{
+		status = E_SEM_INVALID;
+	}
+	else if ((sem = os_kobj_alloc(KOBJ_SEM, sizeof(struct _sem))) == NULL)
+	{
+		status = E_SYS_MEMORY;
+	}
+	else
+	{
+		os_sem_setup(sem, init_count, max_count, FALSE);
+
+		*semid = (UINT32)sem;
+	}
+
+	service_error_check(S_SEM_CREATE, status);
+
+	return status;
+}
+
+// Same as sem_create(), in the caller's storage.
+STATUS sem_init(SEM *sem, UINT32 *semid, UINT32 init_count, UINT32 max_count)
+{
+	STATUS status = E_OK;
+
+	if ((sem == NULL) || (max_count == 0) || (init_count > max_count))
+	{
+		status = E_SEM_INVALID;
+	}
+	else
+	{
+		os_sem_setup(sem, init_count, max_count, TRUE);
+
+		*semid = (UINT32)sem;
+	}
+
+	service_error_check(S_SEM_INIT, status);
+
+	return status;
+}
+
+STATUS sem_destroy(UINT32 semid)
+{
+	STATUS status = E_OK;
+	SEM *sem = (SEM *)semid;
+
+	if (sem == NULL)
+	{
+		status = E_SEM_INVALID;
+	}
+	else if (sem->wait_queue.head != NULL)
+	{
+		status = E_OS_PERMISSION;	/* threads are waiting for it */
+	}
+	else
+	{
+		os_sched_lock();
+
+		if (!sem->is_static)
+		{
+			os_kobj_free(KOBJ_SEM, sem);
+		}
+
+		os_sched_unlock();
+	}
+
+	service_error_check(S_SEM_DESTROY, status);
+
+	return status;
+}
+
+STATUS sem_wait_timeout(UINT32 semid, UINT32 timeout)
+{
+	STATUS status = E_OK;
+	SEM *sem = (SEM *)semid;
+
+	if (NOS_IS_ISR_MODE())
+	{
+		status = E_OS_PERMISSION;
+	}
+	else if (sem == NULL)
+	{
+		status = E_SEM_INVALID;
+	}
+	else
+	{
+		os_sched_lock();
+		if (sem->count > 0)
+		{
+			sem->count--;
+
+			os_sched_unlock();
+		}
+		else if (timeout == 0)
+		{
+			os_sched_unlock();
+
+			return E_TIMEOUT;
+		}
+		else
+		{
+			os_wait_block(&sem->wait_queue, timeout);
+
+			os_sched_unlock_switch();
+
+			/* the count was handed to us, or the wait timed out */
+			if (current_thread->wait_status != E_OK)
+			{
+				return current_thread->wait_status;
+			}
+		}
+	}
+
+	service_error_check(S_SEM_WAIT, status);
+
+	return status;
+}
+
+STATUS sem_wait(UINT32 semid)
+{
+	return sem_wait_timeout(semid, WAIT_FOREVER);
+}
+
+// It can be called in ISR mode.
+STATUS sem_post(UINT32 semid)
+{
+	STATUS status = E_OK;
+	SEM *sem = (SEM *)semid;
+	THREAD *thread;
+
+	if (sem == NULL)
+	{
+		status = E_SEM_INVALID;
+	}
+	else
+	{
+		os_sched_lock();
+
+		/* the highest priority waiter takes the count at once */
+		thread = pop_tnode(&sem->wait_queue);
+
+		if (thread != NULL)
+		{
+			os_wait_wakeup(thread);
+		}
+		else if (sem->count < sem->max_count)
+		{
+			sem->count++;
+		}
+		else
+		{
+			os_sched_unlock();
+
+			return E_SEM_FULL;	/* a binary semaphore that is already given, etc. */
+		}
+
+		os_sched_unlock_switch();
+	}
+
+	service_error_check(S_SEM_POST, status);
+
+	return status;
+}
+
+UINT32 sem_get_count(UINT32 semid)
+{
+	SEM *sem = (SEM *)semid;
+
+	return sem->count;
+}
+
+#endif // SEM_M
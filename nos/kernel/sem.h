@@ -0,0 +1,43 @@
+//===================================================================
+//
+// sem.h
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+#ifndef SEM_H
+#define SEM_H
+#include "kconf.h"
+#include "thread.h"
+#include "queue_thread.h"
+
+#include "nos_common.h"
+
+#ifdef SEM_M
+
+/*
+ * Counting semaphore; a binary one is a semaphore with max_count 1.
+ * Waiters are queued by priority. sem_post() may be called from an ISR,
+ * the context switch then happens when the ISR returns.
+ */
+typedef struct _sem
+{
+	UINT32	count;
+	UINT32	max_count;
+	TQUEUE	wait_queue;	// ordered by priority, FIFO among equals
+	BOOL	is_static;	// from sem_init(), not freed by sem_destroy()
+} SEM;
+
+#define SEM_BINARY	(1)
+#define SEM_COUNTING	(0xFFFFFFFF)
+
+UINT32 sem_create(UINT32 *semid, UINT32 init_count, UINT32 max_count);
+UINT32 sem_init(SEM *sem, UINT32 *semid, UINT32 init_count, UINT32 max_count);
+UINT32 sem_destroy(UINT32 semid);
+UINT32 sem_wait(UINT32 semid);
+UINT32 sem_wait_timeout(UINT32 semid, UINT32 timeout);
+UINT32 sem_post(UINT32 semid);
+UINT32 sem_get_count(UINT32 semid);
+
+#endif // SEM_M
+#endif // ~SEM_H
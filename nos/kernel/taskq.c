@@ -19,7 +19,9 @@ TASKQ taskq;
 extern THREAD *super_thread;
 extern EVENT_MASK super_event;
 
-/* Work Queue : a set of functions to be run by the system thread as soon as possible */
+/* Work Queue : a set of functions to be run by the system thread as soon as possible.
+   It has a fixed length and a single worker; see workq.c for work queues
+   with caller-allocated items and workers of any priority. */
 void os_taskq_init()
 {
     taskq.head = taskq.tail = 0;
@@ -33,12 +35,12 @@ STATUS taskq_register(void (*func)(void *args), void *args)
 	UINT32 foo;
 
 	os_sched_lock();
-	foo = (taskq.tail+1)%TASKQ_LEN;
+	foo = (taskq.tail+1) & TASKQ_MASK;
 
 	/* insert *func into work queue. */
 	if (taskq.head == foo)		// if queue is full
 	{
-		os_sched_lock();
+		os_sched_unlock();
 		
 		status = E_TASKQ_FULL;
 	}
@@ -68,7 +70,7 @@ void os_taskq_exe(void)
 	while ( taskq.head != taskq.tail )	// not empty
 	{
 		pos = taskq.head;
-		taskq.head = (taskq.head+1)%TASKQ_LEN;	// move to the next work
+		taskq.head = (taskq.head+1) & TASKQ_MASK;	// move to the next work
 		
 		(taskq.task[pos].func)(taskq.task[pos].args);	// execute a work function
     }
@@ -12,7 +12,19 @@
 
 #include "nos_common.h"
 
-#define TASKQ_LEN          (5) // task queue length
+// task queue length (a power of two, one slot is kept free)
+#if defined TASKQ_LEN_8
+#define TASKQ_LEN          (8)
+#elif defined TASKQ_LEN_16
+#define TASKQ_LEN          (16)
+#elif defined TASKQ_LEN_64
+#define TASKQ_LEN          (64)
+#elif defined TASKQ_LEN_128
+#define TASKQ_LEN          (128)
+#else
+#define TASKQ_LEN          (32)
+#endif
+#define TASKQ_MASK         (TASKQ_LEN - 1)
 
 typedef struct _task
 {
@@ -31,6 +31,29 @@
 // option
 #define FIFO	(0)
 #define RR		(1)
+#define EDF		(2)	// set by thread_set_edf(), not a thread_create() option
+
+// timeout of blocking calls (ticks)
+#define WAIT_FOREVER	(0xFFFFFFFF)
+
+// default time slice of RR threads (ticks)
+#ifndef CONFIG_RR_QUANTUM
+#define CONFIG_RR_QUANTUM	5
+#endif
+
+// priority level of the EDF threads, ordered by deadline within it
+#ifndef CONFIG_EDF_PRIORITY
+#ifdef PRIORITY_LEVELS_8
+#define CONFIG_EDF_PRIORITY	5	// level 6 is the timer thread's
+#else
+#define CONFIG_EDF_PRIORITY	6
+#endif
+#endif
+#define EDF_NO_DEADLINE		(0xFFFFFFFFFFFFFFFFULL)
+
+// static stack for thread_init(): size bytes of stack plus the guard area
+#define THREAD_STACK_WORDS(size)	(((size) + STACK_GUARD_SIZE + sizeof(STACK_ENTRY) - 1) / sizeof(STACK_ENTRY))
+#define THREAD_STACK_DEFINE(name, size)	STACK_ENTRY name[THREAD_STACK_WORDS(size)] __attribute__((aligned(8)))
 
 typedef struct cpucontext
 {
@@ -56,6 +79,9 @@ typedef struct cpucontext
 	//UINT32 *lrex;
 } CPUcontext;
 
+struct _tqueue;
+struct _mutex;
+
 typedef struct _tcb
 {
 	CPUcontext  *context;
@@ -63,7 +89,8 @@ typedef struct _tcb
 	void 		(*func)(void *);  // function pointer
 	void		*args_data;	  // function arguments
 	UINT32 		state;		  // thread state
-	UINT32   	priority; 	  // thread priority
+	UINT32   	priority; 	  // thread priority (inherited one while it holds a mutex)
+	UINT32		base_priority;	  // thread priority of its own
     //STACK_PTR 	sptr;             //added by phj. @160229 // thread stack pointer
 	STACK_PTR 	stack_start;
 	STACK_PTR	stack_bottom;
@@ -76,6 +103,13 @@ typedef struct _tcb
 	/* for sleep handling */
 	DNODE		sleep_dnode;
 
+	/* for blocking on a kernel object (sleep_dnode is the timeout) */
+	struct _tqueue	*wait_q;	  // queue the thread waits in, NULL if none
+	struct _mutex	*wait_mutex;	  // mutex the thread waits for
+	struct _mutex	*held_mutex;	  // mutexes the thread owns (list)
+	STATUS		wait_status;	  // E_OK, or E_TIMEOUT if the wait gave up
+	void		*wait_buf;	  // message (msgq) or condition (event group) of a blocked call
+
 	/* for ready queue handling */
 	//NODE 		rdy_node;
 	struct _tcb	*prev;
@@ -84,6 +118,31 @@ typedef struct _tcb
 	/* misc */
 	UINT32		vid;
 	UINT32		option;
+
+	/* round robin (option RR) */
+	UINT32		quantum;	  // time slice in ticks
+
+#ifdef THREAD_STATS
+	/* statistics */
+	UINT32		switch_cnt;	  // voluntary context switches (blocking, thread_yield)
+	UINT32		preempt_cnt;	  // involuntary context switches (preemption, time slice)
+#endif
+
+#ifdef THREAD_PERIODIC
+	/* periodic threads (thread_wait_next_period) */
+	UINT32		period;		  // ticks, 0 if not periodic
+	UINT32		deadline;	  // ticks after each release
+	UINT64		release;	  // tick of the current release
+	UINT32		overrun_cnt;	  // jobs still running at the next release
+	UINT32		deadline_miss_cnt; // jobs finished after their deadline
+	UINT32		max_response_us;  // worst release-to-completion time
+#endif
+
+#ifdef EDF_SCHED
+	/* earliest deadline first (option EDF) */
+	UINT64		abs_deadline;	  // tick of the current deadline (inherited one while it holds a mutex)
+	UINT64		base_deadline;	  // tick of the current deadline of its own
+#endif
 }_TCB;
 
 
@@ -92,6 +151,7 @@ typedef _TCB THREAD;
 void thread_entry(void);
 UINT32 thread_create(void (*func)(void *args), void *args_data, UINT32 stack_size, UINT32 priority, UINT32 option, UINT32 *threadId);
 UINT32 thread_spawn(void (*func)(void *args), void *args_data, UINT32 stack_size, UINT32 priority, UINT32 option, UINT32 *threadId);
+STATUS thread_init(THREAD *thread, STACK_PTR stack, UINT32 stack_bytes, void (*func)(void *args), void *args_data, UINT32 priority, UINT32 option, UINT32 *threadId);
 UINT32 thread_terminate(UINT32 tid);
 UINT32 thread_activate(UINT32 tid);
 UINT32 thread_chain(UINT32 tid);
@@ -99,12 +159,39 @@ UINT32 thread_sleep(UINT32 tick);
 UINT32 thread_wait(UINT32 tid);
 UINT32 thread_wakeup(UINT32 tid);
 void thread_yield(void);
+void os_wait_block(struct _tqueue *q, UINT32 timeout);
+void os_wait_wakeup(THREAD *thread);
+void os_wait_cancel(THREAD *thread, STATUS status);
+STATUS thread_priority_change(UINT32 tid, UINT32 new_priority);
+STATUS thread_set_quantum(UINT32 tid, UINT32 quantum);
+#ifdef THREAD_PERIODIC
+STATUS thread_create_periodic(void (*func)(void *args), void *args_data, UINT32 stack_size, UINT32 priority, UINT32 period, UINT32 deadline, UINT32 *threadId);
+STATUS thread_set_periodic(UINT32 tid, UINT32 period, UINT32 deadline);
+STATUS thread_wait_next_period(void);
+#endif
+#ifdef EDF_SCHED
+STATUS thread_set_edf(UINT32 tid);
+STATUS thread_set_deadline(UINT32 tid, UINT32 deadline);
+void os_edf_set_deadline(THREAD *thread, UINT64 abs_deadline);
+#endif
 
 // returns thread information
 #define get_thread_id()			((UINT32) current_thread)
 #define get_thread_vid()		(current_thread->vid)
 #define get_thread_state(threadId)	(((THREAD *)(threadId))->state)
-#define get_thread_priority(threadId)	(((THREAD *)(threadId))->basePriority)
+#define get_thread_priority(threadId)	(((THREAD *)(threadId))->priority)
 #define get_thread_stack_pointer(threadId) (((THREAD *)(threadId))->sptr)
+#ifdef THREAD_STATS
+#define get_thread_switch_count(threadId)	(((THREAD *)(threadId))->switch_cnt)
+#define get_thread_preempt_count(threadId)	(((THREAD *)(threadId))->preempt_cnt)
+#endif
+#ifdef THREAD_PERIODIC
+#define get_thread_overrun_count(threadId)	(((THREAD *)(threadId))->overrun_cnt)
+#define get_thread_deadline_miss_count(threadId)	(((THREAD *)(threadId))->deadline_miss_cnt)
+#define get_thread_max_response_us(threadId)	(((THREAD *)(threadId))->max_response_us)
+#endif
+#ifdef EDF_SCHED
+#define get_thread_abs_deadline(threadId)	(((THREAD *)(threadId))->abs_deadline)
+#endif
 
 #endif // ~THREAD_H
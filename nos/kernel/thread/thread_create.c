@@ -11,6 +11,7 @@
 #include "platform.h"
 #include "critical_section.h"
 #include "heap.h"
+#include "mempool.h"
 #include "sched.h"
 #include "hal_sched.h"
 #include "error.h"
@@ -75,6 +76,76 @@ void os_memset_zero(STACK_PTR mem_s, STACK_PTR mem_e)
 }
 #endif
 
+/* sets up the TCB of a new thread on the given stack (stack_size bytes, guard excluded) */
+static STATUS os_thread_setup(THREAD *thread, STACK_PTR stack, UINT32 stack_size, void (*func)(void *args), void *args_data, UINT32 priority, UINT32 option)
+{
+	UINT32 align;
+	UINT32 th_stack_bott_addr, th_size_cpucontext, th_context;
+
+	thread->ptr 			= thread;				
+	thread->priority 	= priority;
+	thread->base_priority	= priority;
+
+	/* stack management: structure's size */
+	thread->stack_start		= stack;
+	thread->stack_size 		= stack_size;
+	thread->stack_bottom   	= stack_bottom(thread);
+	//Edited by phj.  @phj
+	th_stack_bott_addr		= (UINT32) thread->stack_bottom;
+	align						= (sizeof(struct cpucontext) >> 2)%4;
+	th_size_cpucontext		= (sizeof(struct cpucontext) >> 2) + (4-align);
+	th_context				= th_stack_bott_addr - th_size_cpucontext;
+	thread->context			= (CPUcontext*) th_context;
+	
+	// To measure the amount of stack used so far
+	//os_memset_zero(tcb[tid]->stack_mem_start, tcb[tid]->stack_mem_end);
+
+	thread->func		  	= func;
+	thread->args_data	  	= args_data;
+	thread->vid 			= global_vid_counter++;		//dummy data.
+
+	// event processing	101201 @sheart
+	thread->set_em			= 0;
+	thread->wait_em			= 0;
+
+	init_dnode(&thread->sleep_dnode, os_tsleep_exe, (UINT32)thread);
+	thread->wait_q			= NULL;
+	thread->wait_mutex		= NULL;
+	thread->held_mutex		= NULL;
+	thread->wait_status		= E_OK;
+	thread->wait_buf		= NULL;
+
+	init_tnode(thread);
+	//thread->rdy_node.value = thread->vid;
+
+	thread->state = TS_SUSPEND;
+	thread->option = option;
+	thread->quantum = CONFIG_RR_QUANTUM;
+#ifdef THREAD_STATS
+	thread->switch_cnt = 0;
+	thread->preempt_cnt = 0;
+#endif
+#ifdef THREAD_PERIODIC
+	thread->period = 0;
+	thread->overrun_cnt = 0;
+	thread->deadline_miss_cnt = 0;
+	thread->max_response_us = 0;
+#endif
+#ifdef EDF_SCHED
+	thread->abs_deadline = EDF_NO_DEADLINE;
+	thread->base_deadline = EDF_NO_DEADLINE;
+#endif
+		
+	os_thread_context_init(thread->context);
+
+	if (option != FIFO && option != RR)
+	{
+		return E_THREAD_OPTION;			
+	}
+
+	return E_OK;
+}
+
 STATUS thread_create(void (*func)(void *args), void *args_data, UINT32 stack_size, UINT32 priority, UINT32 option, UINT32 *threadId)
 {
 	STATUS status = E_OK;
@@ -90,7 +161,7 @@ STATUS thread_create(void (*func)(void *args), void *args_data, UINT32 stack_siz
 		
 		// tcb (thread control block) settings when creating thread
 		// A thread has id (*ptid), initialized stack memory, stack pointer and the number of sleeping ticks (sleep_tick) if sleeping.
-		if ((thread = nos_malloc(sizeof(struct _tcb))) == NULL) 
+		if ((thread = os_kobj_alloc(KOBJ_THREAD, sizeof(struct _tcb))) == NULL) 
 		{
 			status = E_SYS_MEMORY;
 			service_error_check(S_THREAD_CREATE, status);
@@ -110,8 +181,9 @@ STATUS thread_create(void (*func)(void *args), void *args_data, UINT32 stack_siz
 				stack_size = stack_size + sizeof(STACK_ENTRY) - align;
 			}
 			
-			if ((stack = nos_malloc(stack_size+STACK_GUARD_SIZE)) == NULL)
+			if ((stack = os_thread_malloc(stack_size+STACK_GUARD_SIZE)) == NULL)
 			{
+				os_kobj_free(KOBJ_THREAD, thread);
 				status = E_SYS_MEMORY;
 				service_error_check(S_THREAD_CREATE, status);
 
@@ -119,49 +191,9 @@ STATUS thread_create(void (*func)(void *args), void *args_data, UINT32 stack_siz
 			}
 			else
 			{
-
 				*threadId = (UINT32) thread;
-				
-				thread->ptr 			= thread;				
-				thread->priority 	= priority;
-
-				/* stack management: structure's size */
-				UINT32 th_stack_bott_addr, th_size_cpucontext, th_context;
-				thread->stack_start		= stack;
-				thread->stack_size 		= stack_size;
-				thread->stack_bottom   	= stack_bottom(thread);
-				//Edited by phj.  @phj
-				th_stack_bott_addr		= (UINT32) thread->stack_bottom;
-				align						= (sizeof(struct cpucontext) >> 2)%4;
-				th_size_cpucontext		= (sizeof(struct cpucontext) >> 2) + (4-align);
-				th_context				= th_stack_bott_addr - th_size_cpucontext;
-				thread->context			= (CPUcontext*) th_context;
-				
-				// To measure the amount of stack used so far
-				//os_memset_zero(tcb[tid]->stack_mem_start, tcb[tid]->stack_mem_end);
-
-				thread->func		  	= func;
-				thread->args_data	  	= args_data;
-				thread->vid 			= global_vid_counter++;		//dummy data.
-
-				// event processing	101201 @sheart
-				thread->set_em			= 0;
-				thread->wait_em			= 0;
-
-				init_dnode(&thread->sleep_dnode, os_tsleep_exe, (UINT32)thread);
-			
-				init_tnode(thread);
-				//thread->rdy_node.value = thread->vid;
-
-				thread->state = TS_SUSPEND;
-				thread->option = option;
-					
-				os_thread_context_init(thread->context);
-
-				if (option != FIFO && option != RR)
-				{
-					status = E_THREAD_OPTION;			
-				}
+
+				status = os_thread_setup(thread, stack, stack_size, func, args_data, priority, option);
 			}
 		}
 	}
@@ -171,6 +203,36 @@ STATUS thread_create(void (*func)(void *args), void *args_data, UINT32 stack_siz
 	return status;
 }
 
+/*
+ * Same as thread_create(), on a TCB and a stack of the caller; the heap is
+ * not used. stack_bytes is the whole size of the stack array, guard area
+ * included, as defined by THREAD_STACK_DEFINE().
+ */
+STATUS thread_init(THREAD *thread, STACK_PTR stack, UINT32 stack_bytes, void (*func)(void *args), void *args_data, UINT32 priority, UINT32 option, UINT32 *threadId)
+{
+	STATUS status = E_OK;
+
+	if (priority >= PRIORITY_LEVEL_COUNT)
+	{
+		status = E_THREAD_PRIORITY;
+	}
+	else if ((thread == NULL) || (stack == NULL) || (stack_bytes <= STACK_GUARD_SIZE + sizeof(struct cpucontext)))
+	{
+		status = E_THREAD_INVALID;
+	}
+	else
+	{
+		*threadId = (UINT32) thread;
+
+		/* the bottom of the stack stays 8-byte aligned */
+		status = os_thread_setup(thread, stack, (stack_bytes - STACK_GUARD_SIZE) & ~7U, func, args_data, priority, option);
+	}
+
+	service_error_check(S_THREAD_INIT, status);
+
+	return status;
+}
+
 STATUS thread_spawn(void (*func)(void *args), void *args_data, UINT32 stack_size, UINT32 priority, UINT32 option, UINT32 *threadId)
 {
 	STATUS status = E_OK;
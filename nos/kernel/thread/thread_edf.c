@@ -0,0 +1,87 @@
+//===================================================================
+//
+// thread_edf.c
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+
+#include "kconf.h"
+
+#ifdef EDF_SCHED
+
+#include "thread.h"
+
+#include "critical_section.h"
+#include "sched.h"
+#include "tick.h"
+#include "thread_table.h"
+#include "mutex.h"
+#include "error.h"
+
+/*
+ * Earliest deadline first: EDF threads share the priority level
+ * CONFIG_EDF_PRIORITY, where the ready list is ordered by absolute deadline
+ * (os_qPush). They preempt the fixed-priority threads below that level and
+ * are preempted by those above it. A periodic EDF thread gets the deadline
+ * release + deadline at each release; an aperiodic one sets it with
+ * thread_set_deadline().
+ */
+
+// moves the thread within the ready list if it is there, and passes the
+// change on to the owner of the mutex it waits for (deadline inheritance)
+void os_edf_set_deadline(THREAD *thread, UINT64 abs_deadline)
+{
+	thread->base_deadline = abs_deadline;
+	os_mutex_priority_update(thread);
+}
+
+STATUS thread_set_edf(UINT32 tid)
+{
+	STATUS status;
+	THREAD *thread = (THREAD *) tid;
+
+	os_sched_lock();
+
+	thread->option = EDF;
+#ifdef THREAD_PERIODIC
+	if (thread->period)
+	{
+		thread->base_deadline = thread->release + thread->deadline;
+	}
+#endif
+
+	os_sched_unlock();
+
+	/* requeues the thread by deadline if it is ready */
+	status = thread_priority_change(tid, CONFIG_EDF_PRIORITY);
+
+	service_error_check(S_THREAD_SET_EDF, status);
+
+	return status;
+}
+
+STATUS thread_set_deadline(UINT32 tid, UINT32 deadline)
+{
+	STATUS status = E_OK;
+	THREAD *thread = (THREAD *) tid;
+
+	if (thread->option != EDF)
+	{
+		status = E_THREAD_OPTION;
+	}
+	else
+	{
+		os_sched_lock();
+
+		os_edf_set_deadline(thread, os_tick_get() + deadline);
+
+		os_sched_unlock_switch();
+	}
+
+	service_error_check(S_THREAD_SET_DEADLINE, status);
+
+	return status;
+}
+
+#endif // EDF_SCHED
@@ -0,0 +1,149 @@
+//===================================================================
+//
+// thread_periodic.c
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+
+#include "kconf.h"
+
+#ifdef THREAD_PERIODIC
+
+#include "thread.h"
+
+#include "critical_section.h"
+#include "sched.h"
+#include "tick.h"
+#include "thread_table.h"
+#include "error.h"
+
+extern THREAD *current_thread;
+
+#define TICK_US		(SCHED_TIMER_MS * 1000)
+
+/*
+ * A periodic thread is released every period ticks, counted from absolute
+ * ticks, so the work time does not shift the releases. Each job ends with
+ * thread_wait_next_period(). A job that finishes later than deadline ticks
+ * after its release is a deadline miss; a job still running at the next
+ * release is an overrun, and the releases it missed are skipped.
+ * With thread_set_edf(), each job is scheduled by its deadline tick.
+ */
+STATUS thread_set_periodic(UINT32 tid, UINT32 period, UINT32 deadline)
+{
+	STATUS status = E_OK;
+	THREAD *thread = (THREAD *) tid;
+
+	if (period == 0)
+	{
+		status = E_THREAD_OPTION;
+	}
+	else
+	{
+		os_sched_lock();
+
+		thread->period = period;
+		thread->deadline = deadline ? deadline : period;
+		thread->release = os_tick_get();	/* the first job is released now */
+		thread->overrun_cnt = 0;
+		thread->deadline_miss_cnt = 0;
+		thread->max_response_us = 0;
+#ifdef EDF_SCHED
+		if (thread->option == EDF)
+		{
+			os_edf_set_deadline(thread, thread->release + thread->deadline);
+		}
+#endif
+
+		os_sched_unlock_switch();
+	}
+
+	service_error_check(S_THREAD_SET_PERIODIC, status);
+
+	return status;
+}
+
+STATUS thread_create_periodic(void (*func)(void *args), void *args_data, UINT32 stack_size, UINT32 priority, UINT32 period, UINT32 deadline, UINT32 *threadId)
+{
+	STATUS status;
+
+	status = thread_create(func, args_data, stack_size, priority, FIFO, threadId);
+	if (status == E_OK)
+	{
+		status = thread_set_periodic(*threadId, period, deadline);
+	}
+
+	return status;
+}
+
+STATUS thread_wait_next_period(void)
+{
+	STATUS status = E_OK;
+	THREAD *thread = current_thread;
+	UINT64 now, next, response;
+
+	if (NOS_IS_ISR_MODE())
+	{
+		status = E_OS_PERMISSION;
+	}
+	else if (thread->period == 0)
+	{
+		status = E_THREAD_OPTION;
+	}
+	else
+	{
+		os_sched_lock();
+
+		/* accounting of the job that ends here */
+		response = os_time_get_us() - thread->release * TICK_US;
+		if (response > thread->max_response_us)
+		{
+			thread->max_response_us = (UINT32) response;
+		}
+		if (response > (UINT64) thread->deadline * TICK_US)
+		{
+			thread->deadline_miss_cnt++;
+		}
+
+		now = os_tick_get();
+		next = thread->release + thread->period;
+
+		if (now >= next)
+		{
+			/* overrun: the next job starts right away, from the last release */
+			thread->overrun_cnt++;
+			thread->release = next + ((now - next) / thread->period) * thread->period;
+#ifdef EDF_SCHED
+			if (thread->option == EDF)
+			{
+				/* the new job may no longer be the earliest one */
+				os_edf_set_deadline(thread, thread->release + thread->deadline);
+			}
+#endif
+			os_sched_unlock_switch();
+		}
+		else
+		{
+			thread->release = next;
+#ifdef EDF_SCHED
+			if (thread->option == EDF)
+			{
+				os_edf_set_deadline(thread, next + thread->deadline);
+			}
+#endif
+
+			os_qRemove(thread);
+			thread->state = TS_SLEEP;
+			tickq_Push(&thread->sleep_dnode, (UINT32) (next - now));
+
+			os_sched_unlock_switch();
+		}
+	}
+
+	service_error_check(S_THREAD_WAIT_NEXT_PERIOD, status);
+
+	return status;
+}
+
+#endif // THREAD_PERIODIC
@@ -12,6 +12,7 @@
 #include "critical_section.h"
 #include "sched.h"
 #include "thread_table.h"
+#include "mutex.h"
 #include "error.h"
 
 // This function should not use local variables because it is used in os_sched_handler()
@@ -20,7 +21,7 @@ STATUS thread_priority_change(UINT32 tid, UINT32 new_priority)
 	STATUS status = E_OK;
 	THREAD *thread = (THREAD *) tid;
 
-	if (thread->priority >= PRIORITY_LEVEL_COUNT)
+	if (new_priority >= PRIORITY_LEVEL_COUNT)
 	{
 		status = E_THREAD_PRIORITY;
 	}
@@ -30,17 +31,20 @@ STATUS thread_priority_change(UINT32 tid, UINT32 new_priority)
 		{
 			os_sched_lock();
 			
-			thread->priority = new_priority; // just change its priority
+			thread->base_priority = new_priority;
+			os_mutex_priority_update(thread); // an inherited priority may still be higher
 			
-			os_sched_unlock();
+			os_sched_unlock_switch();
 		}
 		else if (thread->state == TS_READY)
 		{
 			os_sched_lock();
 			
 			os_qRemove(thread);
-			thread->priority = new_priority; // just change its priority
+			thread->base_priority = new_priority;
+			thread->priority = new_priority;
 			os_qPush(thread);
+			os_mutex_priority_update(thread);
 			
 			os_sched_unlock_switch();
 		}
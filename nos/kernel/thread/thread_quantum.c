@@ -0,0 +1,37 @@
+//===================================================================
+//
+// thread_quantum.c (@sheart)
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+
+#include "thread.h"
+
+#include "critical_section.h"
+#include "sched.h"
+#include "error.h"
+
+// Sets the time slice of an RR thread. It takes effect from the next slice.
+STATUS thread_set_quantum(UINT32 tid, UINT32 quantum)
+{
+	STATUS status = E_OK;
+	THREAD *thread = (THREAD *) tid;
+
+	if (quantum == 0)
+	{
+		status = E_THREAD_OPTION;
+	}
+	else
+	{
+		os_sched_lock();
+
+		thread->quantum = quantum;
+
+		os_sched_unlock();
+	}
+
+	service_error_check(S_THREAD_SET_QUANTUM, status);
+
+	return status;
+}
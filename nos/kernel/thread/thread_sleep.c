@@ -14,6 +14,7 @@
 #include "tick.h"
 #include "thread_table.h"
 #include "queue_thread.h"
+#include "mutex.h"
 #include "error.h"
 
 extern THREAD *current_thread;
@@ -57,12 +58,74 @@ STATUS thread_sleep(UINT32 tick)
 	return status;
 }
 
+/*
+ * Blocks current_thread in the wait queue of a kernel object, for at most
+ * timeout ticks (WAIT_FOREVER: no limit). The caller holds the scheduler lock
+ * and calls os_sched_unlock_switch(); wait_status tells how the wait ended.
+ */
+void os_wait_block(TQUEUE *q, UINT32 timeout)
+{
+	os_qRemove(current_thread);
+
+	current_thread->wait_q = q;
+	current_thread->wait_status = E_OK;
+	push_tnode_prio(q, current_thread);
+
+	if (timeout == WAIT_FOREVER)
+	{
+		current_thread->state = TS_WAIT;
+	}
+	else
+	{
+		current_thread->state = TS_SLEEP;
+		tickq_Push(&current_thread->sleep_dnode, timeout);
+	}
+}
+
+/* readies a thread popped from a wait queue: its wait succeeded */
+void os_wait_wakeup(THREAD *thread)
+{
+	if (thread->state == TS_SLEEP)
+	{
+		tickq_Remove(&thread->sleep_dnode);
+	}
+	thread->wait_q = NULL;
+	thread->wait_mutex = NULL;
+
+	os_qPush(thread);
+	thread->state = TS_READY;
+}
+
+/* takes a blocked thread out of the queue of the kernel object it waits for */
+void os_wait_cancel(THREAD *thread, STATUS status)
+{
+	MUTEX *mutex = thread->wait_mutex;
+
+	if (thread->wait_q == NULL)
+	{
+		return;
+	}
+
+	delete_tnode(thread->wait_q, thread);
+	thread->wait_q = NULL;
+	thread->wait_mutex = NULL;
+	thread->wait_status = status;
+
+	if (mutex != NULL)
+	{
+		/* the owner may have inherited the priority of this thread */
+		os_mutex_priority_update(mutex->owner);
+	}
+}
+
 /* os_tsleep_exe handler is executed in ISR mode. 
-   this function is used in thread_create() function.*/
+   this function is used in thread_create() function.
+   it also ends the waits with a timeout. */
 void os_tsleep_exe(UINT32 tid)
 {
 	THREAD *thread = (THREAD *)tid;
 
+	os_wait_cancel(thread, E_TIMEOUT);
 	os_qPush(thread);
 	thread->state = TS_READY;
 }
@@ -53,6 +53,11 @@ STATUS thread_terminate(UINT32 tid)
 				tickq_Remove(&thread->sleep_dnode);
 			}
 
+			if (thread->state & TS_WAIT)
+			{
+				os_wait_cancel(thread, E_TIMEOUT);
+			}
+
 			thread->state = TS_SUSPEND;
 			
 			os_sched_unlock_switch();
@@ -40,6 +40,7 @@ STATUS thread_wakeup(UINT32 tid)
 		
 		if (thread->state & TS_WAIT) /* TS_SLEEP state falls on here, too */
 		{
+			os_wait_cancel(thread, E_TIMEOUT);
 			os_qPush(thread);
 		}
 
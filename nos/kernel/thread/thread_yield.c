@@ -16,6 +16,9 @@
 
 extern THREAD *current_thread;
 extern TQUEUE os_rdy_q[PRIORITY_LEVEL_COUNT]; /* ready queue is an array of QUEUEs */
+#ifdef THREAD_STATS
+extern BOOL os_sched_yielding;
+#endif
 
 void thread_yield(void)
 {
@@ -25,6 +28,9 @@ void thread_yield(void)
 	{
 		os_qRemove(current_thread);
 		os_qPush(current_thread);
+#ifdef THREAD_STATS
+		os_sched_yielding = TRUE;
+#endif
 	}
 	
 	os_sched_unlock_switch();
@@ -9,131 +9,422 @@
 #include "queue_delta.h"
 #include "nos_timer.h"
 #include "error.h"
+#include "tick.h"
 
 #include "lowpower.h"
 
-extern UINT32 SysTick_Reload_OverFlow;
-extern UINT32 __gcounter;
-extern UINT32 __saved_alid;
+/*
+ * tick_q is a hierarchical timing wheel. A node expires at an absolute tick
+ * (DNODE.expires) of the wheel time tickq_now. The 32-bit tick is split into
+ * TICKQ_WHEEL_LEVELS digits of TICKQ_WHEEL_BITS; a node sits at the level of
+ * the highest digit in which its expiry differs from tickq_now, in the slot
+ * of that digit. When tickq_now enters an occupied slot, the slot is cascaded
+ * to the lower levels; level 0 slots hold exact expiries. Nodes that expire
+ * after the tick counter wraps wait in one extra slot.
+ *
+ * Insert and cancel are O(1). The next expiry is found through the occupancy
+ * bitmaps plus a walk of a single slot, so the tick timer (one-shot) still
+ * fires only when something expires. It is reprogrammed only when the next
+ * expiry changes.
+ *
+ * tickq_now follows the time base of the timer HAL (os_tick_get()) whenever
+ * the queue is touched, and is set to the expiry while the handlers run, so a
+ * node queued by a handler is relative to its own expiry and periodic alarms
+ * do not drift. tickq_now never passes a queued expiry.
+ *
+ * Coalescing: a node with slack may expire up to slack ticks late. The timer
+ * is then programmed for the earliest expiry + slack of all nodes, and every
+ * node expired by that time runs in the same interrupt. A node with
+ * DNODE_DEFERRABLE slack is not taken into account at all; it runs at the
+ * first interrupt after its expiry. As long as no node has slack, the
+ * deadline is the earliest expiry. Otherwise it is taken from the slots: each
+ * slot keeps the earliest expiry + slack of its nodes (tickq_due), which is
+ * updated on insert and recomputed from the slot only when its earliest node
+ * leaves, so no search walks the whole queue.
+ */
+#define TICKQ_WHEEL_BITS	4
+#define TICKQ_WHEEL_SIZE	(1 << TICKQ_WHEEL_BITS)		// slots per level
+#define TICKQ_WHEEL_MASK	(TICKQ_WHEEL_SIZE - 1)
+#define TICKQ_WHEEL_LEVELS	(32 / TICKQ_WHEEL_BITS)		// covers the whole UINT32 range
+#define TICKQ_WRAP_SLOT		(TICKQ_WHEEL_LEVELS * TICKQ_WHEEL_SIZE)
 
-DQUEUE	tick_q;
+#define TICKQ_LOWEST_BIT(x)	(31 - NOS_CLZ((x) & (~(x) + 1)))
 
-void tickq_Expired(void);
-void tickq_Init(void)
-{
-	init_dqueue(&tick_q);
-}
+static DNODE *tickq_slot[TICKQ_WRAP_SLOT + 1];
+static UINT16 tickq_map[TICKQ_WHEEL_LEVELS];	// bit n: slot n of the level is occupied
+static UINT32 tickq_due[TICKQ_WRAP_SLOT + 1];	// earliest expiry + slack in the slot
+static UINT16 tickq_due_map[TICKQ_WHEEL_LEVELS + 1];	// bit n: tickq_due of slot n is set
 
-void tickq_Push(DNODE *new_node, UINT32 delta)
+static UINT32 tickq_now;	// wheel time (ticks)
+static UINT32 tickq_next;	// tick the timer is programmed for
+static BOOL tickq_armed;
+static BOOL tickq_expiring;	// tickq_Expired() programs the timer when it is done
+static UINT32 tickq_count;
+static UINT32 tickq_lazy;	// queued nodes with slack
+
+/* counts the node in the earliest expiry + slack of its slot */
+static void tickq_due_add(DNODE *node, UINT32 slot)
 {
-	DNODE *dnode = tick_q.head;
-	UINT32 passed_tick;
-	UINT32 i;
+	UINT16 *map = &tickq_due_map[slot / TICKQ_WHEEL_SIZE];
+	UINT16 bit = 1 << (slot & TICKQ_WHEEL_MASK);
+	UINT32 due;
 
-	passed_tick = os_timer_tick_get();
-	os_timer_tick_stop();
-		
-	/* calibrate the current timer */
-	if (dnode) {
-		if (dnode->delta >= passed_tick) {	
-			if (passed_tick == 1) {
-				dnode->delta -= passed_tick;
-			} // end if
-			actual_idle_tick -= passed_tick;
-		} // end if
+	if (node->slack == DNODE_DEFERRABLE) {
+		return;
 	} // end if
 
-	/* find the appropriate point to insert the new node */
-	for (i = 0; (dnode != NULL) && (delta >= dnode->delta); dnode = dnode->next, i++) {
-		delta -= dnode->delta;
+	due = node->expires + node->slack;
+	if (!(*map & bit) || (due - tickq_now < tickq_due[slot] - tickq_now)) {
+		tickq_due[slot] = due;
+		*map |= bit;
+	} // end if
+} // end func
+
+/* recomputes the earliest expiry + slack of the slot from its nodes */
+static void tickq_due_update(UINT32 slot)
+{
+	DNODE *dnode;
+
+	tickq_due_map[slot / TICKQ_WHEEL_SIZE] &= ~(1 << (slot & TICKQ_WHEEL_MASK));
+	for (dnode = tickq_slot[slot]; dnode != NULL; dnode = dnode->next) {
+		tickq_due_add(dnode, slot);
 	} // end for
+} // end func
 
-	/* set the delta of the new node */
-	new_node->delta = delta;
+static void tickq_link(DNODE *node)
+{
+	UINT32 diff = node->expires ^ tickq_now;
+	UINT32 level, digit, slot;
 
-	/* insert the new node at the last */
-	if (!dnode) {
-		push_dnode(&tick_q, new_node);
+	if (node->expires < tickq_now) {
+		slot = TICKQ_WRAP_SLOT;
 	} else {
-		/* subtract the delta value of the found node and insert the new node */
-		dnode->delta -= delta;
-		
-		/* place the new node before the dnode */
-		insert_dnode(&tick_q, dnode, new_node);		
+		level = diff ? (31 - NOS_CLZ(diff)) / TICKQ_WHEEL_BITS : 0;
+		digit = (node->expires >> (level * TICKQ_WHEEL_BITS)) & TICKQ_WHEEL_MASK;
+		slot = level * TICKQ_WHEEL_SIZE + digit;
+		tickq_map[level] |= (1 << digit);
 	} // end if
 
-	dnode = tick_q.head;
+	node->slot = slot;
+	node->prev = NULL;
+	node->next = tickq_slot[slot];
+	if (node->next) {
+		node->next->prev = node;
+	} // end if
+	tickq_slot[slot] = node;
+	tickq_due_add(node, slot);
+} // end func
 
-#ifdef PWM_M	
-	actual_idle_tick = dnode->delta;
-	//__gcounter += actual_idle_tick * 10;
-	////__saved_alid = dnode->arg;
-#endif	
-	//uart_printf("tickq_Push :: dnode->delta = %d\r\n", dnode->delta);
-	os_timer_tick_set(dnode->delta);
+static void tickq_unlink(DNODE *node)
+{
+	UINT32 slot = node->slot;
+
+	if (node->prev) {
+		node->prev->next = node->next;
+	} else {
+		tickq_slot[slot] = node->next;
+		if ((node->next == NULL) && (slot < TICKQ_WRAP_SLOT)) {
+			tickq_map[slot / TICKQ_WHEEL_SIZE] &= ~(1 << (slot & TICKQ_WHEEL_MASK));
+		} // end if
+	} // end if
+
+	if (node->next) {
+		node->next->prev = node->prev;
+	} // end if
+
+	node->prev = node->next = NULL;
+	node->slot = DNODE_NOT_QUEUED;
+
+	if ((node->slack != DNODE_DEFERRABLE) && (node->expires + node->slack == tickq_due[slot])) {
+		tickq_due_update(slot);
+	} // end if
 } // end func
 
-void tickq_Remove(DNODE *old_node)
+/*
+ * The earliest expiry. All nodes of a level expire before any node of the
+ * levels above, so only the first occupied slot of the lowest occupied level
+ * has to be searched.
+ */
+static BOOL tickq_next_event(UINT32 *when)
 {
-	DNODE *dnode_head = tick_q.head;
-	DNODE *dnode_next = old_node->next;
+	DNODE *dnode;
+	UINT32 level, digit, map, first;
+	UINT32 slot = TICKQ_WRAP_SLOT;
 
-	//uart_printf("tickq_Remove :: called!!\r\n");
+	for (level = 0; level < TICKQ_WHEEL_LEVELS; level++) {
+		digit = (tickq_now >> (level * TICKQ_WHEEL_BITS)) & TICKQ_WHEEL_MASK;
 
-	/* calibrate the current timer if old_node participates in tickling */
-	if (dnode_head == old_node)
-	{	
-		UINT32 passed_tick;
+		/* above level 0, the slot of the current digit is always empty */
+		if (level == 0) {
+			map = tickq_map[0] & ~((1 << digit) - 1);
+		} else {
+			map = tickq_map[level] & ~((2 << digit) - 1);
+		} // end if
 
-		passed_tick = os_timer_tick_get();
-		os_timer_tick_stop();
+		if (map) {
+			slot = level * TICKQ_WHEEL_SIZE + TICKQ_LOWEST_BIT(map);
+			break;
+		} // end if
+	} // end for
 
-		if (old_node->delta >= passed_tick)
-		{	
-			old_node->delta -= passed_tick;
-		}
-	}
-
-	/* update the delta value */
-	if (dnode_next != NULL)
-	{
-		dnode_next->delta += old_node->delta; /* old_node->delta is updated above */
-	}
-	
-	/* delete the old_node from the queue */
-	delete_dnode(&tick_q, old_node);
-
-	if (dnode_head == old_node)
-	{
-		os_timer_tick_set(dnode_next->delta);
-	}
-}
+	if ((dnode = tickq_slot[slot]) == NULL) {
+		return FALSE;
+	} // end if
 
-void tickq_Expired(void) {
-	DNODE *dnode = tick_q.head;
-
-	//uart_printf("tickq_Expired :: called!!\r\n");
-
-	os_timer_tick_stop();
-	
-	if (dnode) {
-		dnode->delta = 0;
-		
-		for (; (dnode != NULL); dnode=tick_q.head) {
-			if (dnode->delta == 0) { /* dnode is expired */
-				/* update the queue by removing the dnode processed */
-				delete_first_dnode(&tick_q, dnode);
-
-				/* dnode's handler is executed. */
-				dnode->handler(dnode->arg);
-			} else {
-				break; /* escape the loop */
+	first = dnode->expires;
+	for (dnode = dnode->next; dnode != NULL; dnode = dnode->next) {
+		if (dnode->expires - tickq_now < first - tickq_now) {
+			first = dnode->expires;
+		} // end if
+	} // end for
+
+	*when = first;
+	return TRUE;
+} // end func
+
+/*
+ * Move tickq_now forward, up to the earliest expiry, and redistribute the
+ * slots it enters to the lower levels.
+ */
+static void tickq_cascade(UINT32 now)
+{
+	DNODE *list, *dnode;
+	UINT32 level, slot;
+
+	if (now < tickq_now) { /* the tick counter wrapped */
+		tickq_now = now;
+		list = tickq_slot[TICKQ_WRAP_SLOT];
+		tickq_slot[TICKQ_WRAP_SLOT] = NULL;
+		tickq_due_map[TICKQ_WHEEL_LEVELS] = 0;
+		while ((dnode = list) != NULL) {
+			list = dnode->next;
+			tickq_link(dnode);
+		} // end while
+	} // end if
+
+	tickq_now = now;
+
+	for (level = TICKQ_WHEEL_LEVELS - 1; level > 0; level--) {
+		slot = level * TICKQ_WHEEL_SIZE + ((now >> (level * TICKQ_WHEEL_BITS)) & TICKQ_WHEEL_MASK);
+
+		if ((list = tickq_slot[slot]) != NULL) {
+			tickq_slot[slot] = NULL;
+			tickq_map[level] &= ~(1 << (slot & TICKQ_WHEEL_MASK));
+			tickq_due_map[level] &= ~(1 << (slot & TICKQ_WHEEL_MASK));
+
+			while ((dnode = list) != NULL) {
+				list = dnode->next;
+				tickq_link(dnode);	/* goes to a lower level */
+			} // end while
+		} // end if
+	} // end for
+} // end func
+
+/*
+ * The tick the timer has to interrupt at: the earliest expiry + slack of the
+ * nodes that are not deferrable, the earliest tickq_due of the slots.
+ */
+static BOOL tickq_deadline(UINT32 *when)
+{
+	UINT32 level, map, slot, rel, best = 0;
+	BOOL found = FALSE;
+
+	if (tickq_lazy == 0) {
+		return tickq_next_event(when);
+	} // end if
+
+	for (level = 0; level <= TICKQ_WHEEL_LEVELS; level++) {
+		for (map = tickq_due_map[level]; map != 0; map &= map - 1) {
+			slot = level * TICKQ_WHEEL_SIZE + TICKQ_LOWEST_BIT(map);
+
+			rel = tickq_due[slot] - tickq_now;
+			if (!found || (rel < best)) {
+				best = rel;
+				found = TRUE;
 			} // end if
 		} // end for
-				
-		/* set the next tick alarm */
-		if ((dnode != NULL) & (SysTick_Reload_OverFlow == 0)) {
-			os_timer_tick_set(dnode->delta);
+	} // end for
+
+	*when = tickq_now + best;
+	return found;
+} // end func
+
+/*
+ * Ticks elapsed since tickq_now, kept below the next expiry so that tickq_now
+ * never skips an event (a late or deferred expiry is pending in that case).
+ */
+static UINT32 tickq_passed(void)
+{
+	UINT32 passed, remain, when;
+
+	if (tickq_expiring) {
+		return 0;
+	} // end if
+
+	passed = (UINT32)os_tick_get() - tickq_now;
+	if (tickq_next_event(&when)) {
+		remain = when - tickq_now;
+		if (passed >= remain) {
+			passed = remain ? remain - 1 : 0;
 		} // end if
 	} // end if
+
+	return passed;
+} // end func
+
+static void tickq_reschedule(void)
+{
+	UINT32 when, delta;
+
+	if (tickq_deadline(&when)) {
+		/* the timer counts from the current tick, which may be past tickq_now */
+		delta = when - (UINT32)os_tick_get();
+		if ((INT32)delta < 0) {
+			delta = 0;
+		} // end if
+
+		tickq_next = when;
+		tickq_armed = TRUE;
+#ifdef PWM_M
+		actual_idle_tick = delta;
+#endif
+		os_timer_tick_set(delta);
+	} else {
+		tickq_armed = FALSE;
+		os_timer_tick_stop();
+	} // end if
+} // end func
+
+void tickq_Init(void)
+{
+	UINT32 i;
+
+	for (i = 0; i <= TICKQ_WRAP_SLOT; i++) {
+		tickq_slot[i] = NULL;
+	} // end for
+	for (i = 0; i < TICKQ_WHEEL_LEVELS; i++) {
+		tickq_map[i] = 0;
+	} // end for
+	for (i = 0; i <= TICKQ_WHEEL_LEVELS; i++) {
+		tickq_due_map[i] = 0;
+	} // end for
+
+	tickq_now = 0;
+	tickq_armed = FALSE;
+	tickq_expiring = FALSE;
+	tickq_count = 0;
+	tickq_lazy = 0;
+} // end func
+
+void tickq_Push(DNODE *new_node, UINT32 delta)
+{
+	UINT32 now;
+
+	/* restarting a queued node */
+	if (new_node->slot != DNODE_NOT_QUEUED) {
+		tickq_unlink(new_node);
+		tickq_count--;
+		if (new_node->slack) {
+			tickq_lazy--;
+		} // end if
+	} // end if
+
+	/* tickq_now may lag behind a deferred expiry, so count from the current tick */
+	if (tickq_expiring) {
+		new_node->expires = tickq_now + delta;
+	} else {
+		now = (UINT32)os_tick_get();
+		if ((INT32)(now - tickq_now) < 0) {
+			now = tickq_now;
+		} // end if
+		new_node->expires = now + delta;
+	} // end if
+	tickq_count++;
+	if (new_node->slack) {
+		tickq_lazy++;
+	} // end if
+
+	if (tickq_expiring || (new_node->slack == DNODE_DEFERRABLE)) {
+		tickq_link(new_node);
+	} else if (!tickq_armed ||
+		   (new_node->expires - tickq_now + new_node->slack < tickq_next - tickq_now)) {
+		/* the new node comes first: catch up with the timer and reprogram it */
+		tickq_cascade(tickq_now + tickq_passed());
+		tickq_link(new_node);
+		tickq_reschedule();
+	} else {
+		tickq_link(new_node);
+	} // end if
+} // end func
+
+void tickq_Remove(DNODE *old_node)
+{
+	UINT32 when;
+
+	if (old_node->slot == DNODE_NOT_QUEUED) {
+		return;
+	} // end if
+
+	tickq_unlink(old_node);
+	tickq_count--;
+	if (old_node->slack) {
+		tickq_lazy--;
+	} // end if
+
+	if (tickq_armed && !tickq_expiring) {
+		if (!tickq_deadline(&when) || (when != tickq_next)) {
+			tickq_cascade(tickq_now + tickq_passed());
+			tickq_reschedule();
+		} // end if
+	} // end if
+} // end func
+
+void tickq_Expired(void) {
+	DNODE *dnode;
+	UINT32 slot, when;
+
+	if (!tickq_armed) {
+		return;
+	} // end if
+
+	tickq_armed = FALSE;
+	tickq_expiring = TRUE;
+
+	/* every node expired by the deadline, in expiry order */
+	while (tickq_next_event(&when) && ((INT32)(when - tickq_next) <= 0)) {
+		tickq_cascade(when);
+
+		/* handlers may queue nodes that expire right now; they are run here too */
+		slot = tickq_now & TICKQ_WHEEL_MASK;
+		while ((dnode = tickq_slot[slot]) != NULL) {
+			tickq_unlink(dnode);
+			tickq_count--;
+			if (dnode->slack) {
+				tickq_lazy--;
+			} // end if
+
+			/* dnode's handler is executed. */
+			dnode->handler(dnode->arg);
+		} // end while
+	} // end while
+
+	tickq_expiring = FALSE;
+
+	/* set the next tick alarm */
+	tickq_reschedule();
+} // end func
+
+UINT32 tickq_Count(void)
+{
+	return tickq_count;
+} // end func
+
+UINT64 os_tick_get(void)
+{
+	return os_timer_time_us() / (SCHED_TIMER_MS * 1000);
+} // end func
+
+UINT64 os_time_get_us(void)
+{
+	return os_timer_time_us();
 } // end func
@@ -12,11 +12,18 @@
 
 #include "nos_common.h"
 #include "hal_sched.h"
+#include "queue_delta.h"
 
 void tickq_Init(void);
 void tickq_Push(DNODE *new_node, UINT32 delta);
 void tickq_Remove(DNODE *old_node);
 void tickq_Expired(void);
+UINT32 tickq_Count(void);	// number of queued nodes
+
+// Monotonic 64-bit time since boot, callable from threads and ISRs.
+// It counts in periodic and tickless (SCHED_TICKLESS) modes alike.
+UINT64 os_tick_get(void);	// ticks (SCHED_TIMER_MS)
+UINT64 os_time_get_us(void);	// microseconds
 
 #endif // ~USER_ALARM_H
 
@@ -0,0 +1,276 @@
+// -*- c-file-style:"bsd"; c-basic-offset:4; indent-tabs-mode:nil; -*-
+/*
+ * Copyright (c) 2006-2012
+ * Electronics and Telecommunications Research Institute (ETRI)
+ * All Rights Reserved.
+ *
+ * Following acts are STRICTLY PROHIBITED except when a specific prior written
+ * permission is obtained from ETRI or a separate written agreement with ETRI
+ * stipulates such permission specifically:
+ *
+ * a) Selling, distributing, sublicensing, renting, leasing, transmitting,
+ * redistributing or otherwise transferring this software to a third party;
+ *
+ * b) Copying, transforming, modifying, creating any derivatives of, reverse
+ * engineering, decompiling, disassembling, translating, making any attempt to
+ * discover the source code of, the whole or part of this software in source or
+ * binary form;
+ *
+ * c) Making any copy of the whole or part of this software other than one copy
+ * for backup purposes only; and
+ *
+ * d) Using the name, trademark or logo of ETRI or the names of contributors in
+ * order to endorse or promote products derived from this software.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITHOUT A WARRANTY OF ANY KIND. ALL
+ * EXPRESS OR IMPLIED CONDITIONS, REPRESENTATIONS AND WARRANTIES, INCLUDING ANY
+ * IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE OR
+ * NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI (OR ITS
+ * LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR
+ * DIRECT, INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES,
+ * HOWEVER CAUSED AND REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE USE OF OR INABILITY TO USE THIS SOFTWARE, EVEN
+ * IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * Any permitted redistribution of this software must retain the copyright
+ * notice, conditions, and disclaimer as specified above.
+ */
+
+/**
+ * @file user_timer.c
+ * @brief User timers on tick_q
+ */
+
+#include "kconf.h"
+
+#ifdef USER_TIMER_M
+
+#include "user_timer.h"
+#include "tick.h"
+#include "sched.h"
+
+static NOS_USER_TIMER nos_user_timer_table[NOS_MAX_NUM_USER_TIMER];
+
+/* tick_q handler (ISR mode) */
+static void nos_user_timer_expired(UINT32 arg)
+{
+    NOS_USER_TIMER *timer = (NOS_USER_TIMER *) arg;
+    void (*func)(void *) = timer->func;
+    void *func_arg = timer->arg;
+
+    if (timer->periodic_ticks)
+    {
+        // relative to this expiry, so the period does not drift
+        tickq_Push(&timer->dnode, timer->periodic_ticks);
+    }
+    else if (timer->id >= 0)
+    {
+        // the slot is free before the function runs, it may create a timer
+        timer->func = NULL;
+    }
+
+    func(func_arg);
+}
+
+void nos_user_timer_init(void)
+{
+    UINT8 i;
+
+    for (i = 0; i < NOS_MAX_NUM_USER_TIMER; i++)
+    {
+        nos_user_timer_table[i].func = NULL;
+        init_dnode(&nos_user_timer_table[i].dnode,
+                   nos_user_timer_expired,
+                   (UINT32) &nos_user_timer_table[i]);
+    }
+}
+
+// tick_q programs the tick timer by itself.
+void nos_user_timer_check_next_expire_tick(void)
+{
+}
+
+UINT16 nos_user_timer_get_max_sec(void)
+{
+    return NOS_USER_TIMER_MAX_SEC;
+}
+
+UINT32 nos_user_timer_get_max_ms(void)
+{
+    return NOS_USER_TIMER_MAX_MS;
+}
+
+UINT32 nos_get_sched_tick_ms(void)
+{
+    return SCHED_TIMER_MS;
+}
+
+void nos_user_timer_setup(NOS_USER_TIMER *timer,
+                          void (*func)(void *),
+                          void *arg,
+                          UINT32 ticks,
+                          BOOL periodic)
+{
+    init_dnode(&timer->dnode, nos_user_timer_expired, (UINT32) timer);
+    timer->func = func;
+    timer->arg = arg;
+    timer->ticks = ticks ? ticks : 1;
+    timer->periodic_ticks = periodic ? timer->ticks : 0;
+    timer->id = -1;
+}
+
+void nos_user_timer_start(NOS_USER_TIMER *timer)
+{
+    os_sched_lock();
+    tickq_Push(&timer->dnode, timer->ticks);
+    os_sched_unlock();
+}
+
+void nos_user_timer_stop(NOS_USER_TIMER *timer)
+{
+    os_sched_lock();
+    tickq_Remove(&timer->dnode);
+    os_sched_unlock();
+}
+
+void nos_user_timer_restart(NOS_USER_TIMER *timer, UINT32 ticks)
+{
+    os_sched_lock();
+    timer->ticks = ticks ? ticks : 1;
+    if (timer->periodic_ticks)
+    {
+        timer->periodic_ticks = timer->ticks;
+    }
+    tickq_Push(&timer->dnode, timer->ticks);
+    os_sched_unlock();
+}
+
+INT8 nos_user_timer_create(void (*func)(void *),
+                           void *arg,
+                           UINT16 ticks,
+                           BOOL is_periodic)
+{
+    NOS_USER_TIMER *timer;
+    INT8 id;
+
+    if (func == NULL)
+    {
+        return NOS_USER_TIMER_CREATE_ERROR;
+    }
+
+    os_sched_lock();
+
+    for (id = 0; id < NOS_MAX_NUM_USER_TIMER; id++)
+    {
+        if (nos_user_timer_table[id].func == NULL)
+        {
+            break;
+        }
+    }
+
+    if (id == NOS_MAX_NUM_USER_TIMER)
+    {
+        os_sched_unlock();
+        return NOS_USER_TIMER_NO_EMPTY_SLOT_ERROR;
+    }
+
+    timer = &nos_user_timer_table[id];
+    nos_user_timer_setup(timer, func, arg, ticks, is_periodic);
+    timer->id = id;
+    tickq_Push(&timer->dnode, timer->ticks);
+
+    os_sched_unlock();
+
+    return id;
+}
+
+INT8 nos_user_timer_create_ms(void (*func)(void *),
+                              void *arg,
+                              UINT16 msec,
+                              BOOL periodic)
+{
+    return nos_user_timer_create(func, arg, MSEC((UINT32) msec), periodic);
+}
+
+INT8 nos_user_timer_create_sec(void (*func)(void *),
+                               void *arg,
+                               UINT16 sec,
+                               BOOL periodic)
+{
+    if (sec > NOS_USER_TIMER_MAX_SEC)
+    {
+        return NOS_USER_TIMER_CREATE_ERROR;
+    }
+    return nos_user_timer_create(func, arg, SEC((UINT32) sec), periodic);
+}
+
+static BOOL nos_user_timer_is_valid(UINT8 id)
+{
+    return (id < NOS_MAX_NUM_USER_TIMER) && (nos_user_timer_table[id].func != NULL);
+}
+
+BOOL nos_user_timer_activate(UINT8 id)
+{
+    if (!nos_user_timer_is_valid(id))
+    {
+        return FALSE;
+    }
+    nos_user_timer_start(&nos_user_timer_table[id]);
+    return TRUE;
+}
+
+BOOL nos_user_timer_deactivate(UINT8 id)
+{
+    if (!nos_user_timer_is_valid(id))
+    {
+        return FALSE;
+    }
+    nos_user_timer_stop(&nos_user_timer_table[id]);
+    return TRUE;
+}
+
+BOOL nos_user_timer_destroy(UINT8 id)
+{
+    BOOL ret = FALSE;
+
+    os_sched_lock();
+    if (nos_user_timer_is_valid(id))
+    {
+        tickq_Remove(&nos_user_timer_table[id].dnode);
+        nos_user_timer_table[id].func = NULL;
+        ret = TRUE;
+    }
+    os_sched_unlock();
+
+    return ret;
+}
+
+BOOL nos_user_timer_reschedule(UINT8 id, UINT16 ticks)
+{
+    if (!nos_user_timer_is_valid(id))
+    {
+        return FALSE;
+    }
+    nos_user_timer_restart(&nos_user_timer_table[id], ticks);
+    return TRUE;
+}
+
+void nos_user_timer_destroy_by_arg(void (*func)(void *),
+                                   void *arg)
+{
+    UINT8 id;
+
+    os_sched_lock();
+    for (id = 0; id < NOS_MAX_NUM_USER_TIMER; id++)
+    {
+        if ((nos_user_timer_table[id].func == func) &&
+            (nos_user_timer_table[id].arg == arg))
+        {
+            tickq_Remove(&nos_user_timer_table[id].dnode);
+            nos_user_timer_table[id].func = NULL;
+        }
+    }
+    os_sched_unlock();
+}
+
+#endif // USER_TIMER_M
@@ -45,7 +45,18 @@
 #ifndef USER_TIMER_H
 #define USER_TIMER_H
 
+#include "kconf.h"
 #include "nos_common.h"
+#include "hal_sched.h"
+#include "queue_delta.h"
+
+/*
+ * User timers run on tick_q, so starting, stopping and rescheduling one is
+ * O(1). A timer whose storage the caller provides (nos_user_timer_setup())
+ * is not limited in number. The ID functions take their timers from a table
+ * of NOS_MAX_NUM_USER_TIMER; a one-shot ID timer is freed when it expires.
+ * The timer functions run in ISR mode.
+ */
 
 enum
 {
@@ -56,9 +67,16 @@ enum
 #define NOS_USER_TIMER_MAX_SEC   ((UINT16) (655 * SCHED_TIMER_MS)/10)
 #define NOS_USER_TIMER_MAX_MS   ((UINT32) (65535 * SCHED_TIMER_MS))
 
+#ifndef CONFIG_USER_TIMER_NUM
+#define CONFIG_USER_TIMER_NUM   16
+#endif
+#if (CONFIG_USER_TIMER_NUM < 1) || (CONFIG_USER_TIMER_NUM > 127)
+#error "CONFIG_USER_TIMER_NUM must be 1..127: timer IDs are INT8"
+#endif
+
 enum
 {
-    NOS_MAX_NUM_USER_TIMER = 16,
+    NOS_MAX_NUM_USER_TIMER = CONFIG_USER_TIMER_NUM,
 };
 
 enum
@@ -69,10 +87,12 @@ enum
 
 typedef struct _nos_user_timer
 {
+    DNODE dnode;                        // tick_q node
     void (*func)(void *);               // user timer function pointer
     void *arg;                          // user timer function argument pointer
-    UINT16 periodic_ticks;              // user timer period 
-    volatile UINT16 next_sched_tick;    // next nos_shced_tick for expiration
+    UINT32 ticks;                       // first expiry, from the (re)start
+    UINT32 periodic_ticks;              // user timer period, 0 for one-shot
+    INT8 id;                            // ID table slot, -1 for caller storage
 } NOS_USER_TIMER;
 
 void nos_user_timer_init(void);
@@ -110,4 +130,16 @@ UINT32 nos_get_sched_tick_ms(void);
 void nos_user_timer_destroy_by_arg(void (*func)(void *),
                                    void *arg);
 
+// Timers with caller storage
+void nos_user_timer_setup(NOS_USER_TIMER *timer,
+                          void (*func)(void *),
+                          void *arg,
+                          UINT32 ticks,
+                          BOOL periodic);
+void nos_user_timer_start(NOS_USER_TIMER *timer);
+void nos_user_timer_stop(NOS_USER_TIMER *timer);
+void nos_user_timer_restart(NOS_USER_TIMER *timer, UINT32 ticks);
+
+#define nos_user_timer_is_active(timer) ((timer)->dnode.slot != DNODE_NOT_QUEUED)
+
 #endif // ~USER_TIMER_H
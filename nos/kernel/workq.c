@@ -0,0 +1,233 @@
+//===================================================================
+//
+// workq.c
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+
+#include "workq.h"
+
+#include "critical_section.h"
+#include "heap.h"
+#include "sched.h"
+#include "thread.h"
+#include "queue_thread.h"
+#include "error.h"
+
+static void os_workq_worker(void *args)
+{
+	WORKQ *wq = (WORKQ *)args;
+	WORK *work;
+	UINT32 n;
+
+	while (1)
+	{
+		os_sched_lock();
+
+		if (wq->head == NULL)
+		{
+			os_wait_block(&wq->idle, WAIT_FOREVER);
+			os_sched_unlock_switch();
+			continue;
+		}
+
+		os_sched_unlock();
+
+		/* each item leaves the queue just before it runs: until then a
+		   handler or an ISR can submit or cancel it like any other */
+		for (n = 0; n < wq->batch; n++)
+		{
+			os_sched_lock();
+
+			if ((work = wq->head) == NULL)
+			{
+				os_sched_unlock();
+				break;
+			}
+
+			wq->head = work->next;
+			if (wq->head == NULL)
+			{
+				wq->tail = NULL;
+			}
+			work->next = NULL;
+			wq->count--;
+			work->pending = 0;	/* it may be submitted again from now on */
+
+			os_sched_unlock();
+
+			work->func(work->args);
+		}
+
+		/* threads of the same priority get the CPU between batches */
+		thread_yield();
+	}
+}
+
+void work_init(WORK *work, void (*func)(void *args), void *args)
+{
+	work->next = NULL;
+	work->func = func;
+	work->args = args;
+	work->pending = 0;
+}
+
+static void os_workq_setup(WORKQ *wq, UINT32 batch)
+{
+	wq->head = wq->tail = NULL;
+	wq->count = 0;
+	wq->max_count = 0;
+	wq->batch = batch ? batch : CONFIG_WORKQ_BATCH;
+	init_tqueue(&wq->idle);
+}
+
+STATUS workq_create(UINT32 *wqid, UINT32 priority, UINT32 stack_size, UINT32 batch)
+{
+	STATUS status = E_OK;
+	WORKQ *wq;
+
+	if ((wq = nos_malloc(sizeof(struct _workq))) == NULL)
+	{
+		status = E_SYS_MEMORY;
+	}
+	else
+	{
+		os_workq_setup(wq, batch);
+
+		status = thread_create(os_workq_worker, wq, stack_size, priority, FIFO, &wq->worker);
+		if (status == E_OK)
+		{
+			*wqid = (UINT32)wq;
+			thread_activate(wq->worker);
+		}
+		else
+		{
+			nos_free(wq);
+		}
+	}
+
+	service_error_check(S_WORKQ_CREATE, status);
+
+	return status;
+}
+
+// Same as workq_create(), with the queue, the worker TCB and its stack
+// (THREAD_STACK_DEFINE) in the caller's storage.
+STATUS workq_init(WORKQ *wq, THREAD *worker, STACK_PTR stack, UINT32 stack_bytes, UINT32 *wqid, UINT32 priority, UINT32 batch)
+{
+	STATUS status = E_OK;
+
+	if (wq == NULL)
+	{
+		status = E_WORKQ_INVALID;
+	}
+	else
+	{
+		os_workq_setup(wq, batch);
+
+		status = thread_init(worker, stack, stack_bytes, os_workq_worker, wq, priority, FIFO, &wq->worker);
+		if (status == E_OK)
+		{
+			*wqid = (UINT32)wq;
+			thread_activate(wq->worker);
+		}
+	}
+
+	service_error_check(S_WORKQ_INIT, status);
+
+	return status;
+}
+
+/* queues the item and wakes the worker up (scheduler locked) */
+void os_work_queue(WORKQ *wq, WORK *work)
+{
+	THREAD *worker;
+
+	if (!work->pending)
+	{
+		work->pending = 1;
+		work->next = NULL;
+		if (wq->tail != NULL)
+		{
+			wq->tail->next = work;
+		}
+		else
+		{
+			wq->head = work;
+		}
+		wq->tail = work;
+
+		if (++wq->count > wq->max_count)
+		{
+			wq->max_count = wq->count;
+		}
+
+		if ((worker = pop_tnode(&wq->idle)) != NULL)
+		{
+			os_wait_wakeup(worker);
+		}
+	}
+}
+
+// It can be called in ISR mode.
+STATUS work_submit(UINT32 wqid, WORK *work)
+{
+	STATUS status = E_OK;
+	WORKQ *wq = (WORKQ *)wqid;
+
+	if ((wq == NULL) || (work == NULL))
+	{
+		status = E_WORKQ_INVALID;
+	}
+	else
+	{
+		os_sched_lock();
+		os_work_queue(wq, work);
+		os_sched_unlock_switch();
+	}
+
+	service_error_check(S_WORK_SUBMIT, status);
+
+	return status;
+}
+
+/* Removes a pending item. Returns FALSE if it was not pending (it may be running). */
+BOOL work_cancel(UINT32 wqid, WORK *work)
+{
+	WORKQ *wq = (WORKQ *)wqid;
+	WORK *p, *prev = NULL;
+	BOOL found = FALSE;
+
+	os_sched_lock();
+
+	if (work->pending)
+	{
+		for (p = wq->head; p != NULL; prev = p, p = p->next)
+		{
+			if (p == work)
+			{
+				if (prev != NULL)
+				{
+					prev->next = p->next;
+				}
+				else
+				{
+					wq->head = p->next;
+				}
+				if (wq->tail == p)
+				{
+					wq->tail = prev;
+				}
+				wq->count--;
+				work->pending = 0;
+				found = TRUE;
+				break;
+			}
+		}
+	}
+
+	os_sched_unlock();
+
+	return found;
+}
@@ -0,0 +1,59 @@
+//===================================================================
+//
+// workq.h
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+#ifndef WORKQ_H
+#define WORKQ_H
+#include "kconf.h"
+#include "thread.h"
+#include "queue_thread.h"
+
+#include "nos_common.h"
+
+/*
+ * Deferred work queues. Each queue has its own worker thread at a priority
+ * chosen at creation, so several queues can run urgent and background work
+ * side by side. Work items are allocated by the caller (usually static) and
+ * linked into the queue, so work_submit() never runs out of slots; it can
+ * be called from ISRs. Submitting an item that is still pending does
+ * nothing. The worker runs up to batch items in a row, taking each off the
+ * queue just before it runs, and lets threads of its own priority run
+ * between batches.
+ */
+#ifndef CONFIG_WORKQ_BATCH
+#define CONFIG_WORKQ_BATCH	8
+#endif
+
+typedef struct _work
+{
+	struct _work	*next;
+	void		(*func)(void *args);
+	void		*args;
+	UINT32		pending;	// queued and not started yet
+} WORK;
+
+typedef struct _workq
+{
+	WORK	*head, *tail;		// pending items, FIFO
+	UINT32	count;			// number of pending items
+	UINT32	max_count;		// high watermark of count
+	UINT32	batch;
+	TQUEUE	idle;			// the worker while the queue is empty
+	UINT32	worker;			// thread id of the worker
+} WORKQ;
+
+#define WORK_INITIALIZER(f, a)	{ NULL, (f), (a), 0 }
+
+void work_init(WORK *work, void (*func)(void *args), void *args);
+UINT32 workq_create(UINT32 *wqid, UINT32 priority, UINT32 stack_size, UINT32 batch);
+UINT32 workq_init(WORKQ *wq, THREAD *worker, STACK_PTR stack, UINT32 stack_bytes, UINT32 *wqid, UINT32 priority, UINT32 batch);
+UINT32 work_submit(UINT32 wqid, WORK *work);
+BOOL work_cancel(UINT32 wqid, WORK *work);
+void os_work_queue(WORKQ *wq, WORK *work);
+
+#define work_is_pending(work)	((work)->pending)
+
+#endif // ~WORKQ_H
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2006-2015  Electronics and Telecommunications Research Institute (ETRI)
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file heap_profile.c
+ * @brief Heap profiler
+ * @ingroup
+ * @copyright GNU General Public License v3
+ */
+
+#include "kconf.h"
+#ifdef HEAP_PROFILE
+
+#include <stdint.h>
+#include "heap_profile.h"
+#include "heap.h"
+#include "tick.h"
+#include "uart.h"
+#include "critical_section.h"
+
+#if (CONFIG_HEAP_PROFILE_BLOCKS & (CONFIG_HEAP_PROFILE_BLOCKS - 1)) != 0
+#error "CONFIG_HEAP_PROFILE_BLOCKS must be a power of two"
+#endif
+
+#define PROF_BLOCK_MASK		(CONFIG_HEAP_PROFILE_BLOCKS - 1)
+#define PROF_SITE_OTHER		(CONFIG_HEAP_PROFILE_SITES - 1)	// call sites that did not fit
+
+typedef struct
+{
+	void	*ptr;			// NULL: empty slot
+	UINT32	len;
+	UINT32	time_ms;
+	UINT32	site;
+} PROF_BLOCK;
+
+typedef struct
+{
+	UINT32	caller;
+	UINT32	allocs;
+	UINT32	alloc_fail;
+	UINT32	live_count;
+	UINT32	live_bytes;
+	UINT32	peak_bytes;
+} PROF_SITE;
+
+/* live blocks, open addressing by address */
+static PROF_BLOCK os_prof_block[CONFIG_HEAP_PROFILE_BLOCKS];
+static PROF_SITE os_prof_site[CONFIG_HEAP_PROFILE_SITES];
+static UINT32 os_prof_nsite;
+static HEAP_PROFILE_SUMMARY os_prof;
+
+static UINT32 os_prof_hash(void *ptr)
+{
+	return ((UINT32)((uintptr_t)ptr >> 3) * 2654435761U) >> 8 & PROF_BLOCK_MASK;
+}
+
+static UINT32 os_prof_site_of(void *caller)
+{
+	UINT32 i;
+
+	for (i = 0; i < os_prof_nsite; i++)
+	{
+		if (os_prof_site[i].caller == (UINT32)(uintptr_t)caller)
+		{
+			return i;
+		}
+	}
+	if (os_prof_nsite == PROF_SITE_OTHER)
+	{
+		return PROF_SITE_OTHER;
+	}
+	os_prof_site[i].caller = (UINT32)(uintptr_t)caller;
+	return os_prof_nsite++;
+}
+
+void os_heap_profile_alloc(void *ptr, UINT32 len, void *caller)
+{
+	PROF_SITE *site = &os_prof_site[os_prof_site_of(caller)];
+	UINT32 i;
+
+	if (ptr == NULL)
+	{
+		os_prof.alloc_fail++;
+		site->alloc_fail++;
+		return;
+	}
+	os_prof.allocs++;
+	site->allocs++;
+
+	if (os_prof.live_count == CONFIG_HEAP_PROFILE_BLOCKS - 1)
+	{
+		os_prof.untracked++;	/* one slot stays empty to end the probes */
+		return;
+	}
+	for (i = os_prof_hash(ptr); os_prof_block[i].ptr != NULL; i = (i + 1) & PROF_BLOCK_MASK);
+	os_prof_block[i].ptr = ptr;
+	os_prof_block[i].len = len;
+	os_prof_block[i].time_ms = (UINT32)(os_time_get_us() / 1000);
+	os_prof_block[i].site = site - os_prof_site;
+
+	site->live_count++;
+	site->live_bytes += len;
+	if (site->live_bytes > site->peak_bytes)
+	{
+		site->peak_bytes = site->live_bytes;
+	}
+	os_prof.live_bytes += len;
+	if (++os_prof.live_count > os_prof.peak_count)
+	{
+		os_prof.peak_count = os_prof.live_count;
+	}
+	if (os_prof.live_bytes > os_prof.peak_bytes)
+	{
+		os_prof.peak_bytes = os_prof.live_bytes;
+	}
+}
+
+void os_heap_profile_free(void *ptr)
+{
+	PROF_SITE *site;
+	UINT32 i, j, k;
+
+	if (ptr == NULL)
+	{
+		return;
+	}
+	os_prof.frees++;
+
+	for (i = os_prof_hash(ptr); os_prof_block[i].ptr != ptr; i = (i + 1) & PROF_BLOCK_MASK)
+	{
+		if (os_prof_block[i].ptr == NULL)
+		{
+			return;		/* untracked */
+		}
+	}
+
+	site = &os_prof_site[os_prof_block[i].site];
+	site->live_count--;
+	site->live_bytes -= os_prof_block[i].len;
+	os_prof.live_count--;
+	os_prof.live_bytes -= os_prof_block[i].len;
+
+	/* moves back the entries after it whose probe passed over the slot */
+	for (j = (i + 1) & PROF_BLOCK_MASK; os_prof_block[j].ptr != NULL; j = (j + 1) & PROF_BLOCK_MASK)
+	{
+		k = os_prof_hash(os_prof_block[j].ptr);
+		if (((j - k) & PROF_BLOCK_MASK) >= ((j - i) & PROF_BLOCK_MASK))
+		{
+			os_prof_block[i] = os_prof_block[j];
+			i = j;
+		}
+	}
+	os_prof_block[i].ptr = NULL;
+}
+
+void heap_profile_get_summary(HEAP_PROFILE_SUMMARY *summary)
+{
+	NOS_ENTER_CRITICAL_SECTION();
+	*summary = os_prof;
+	summary->now_ms = (UINT32)(os_time_get_us() / 1000);
+	NOS_EXIT_CRITICAL_SECTION();
+}
+
+static void os_prof_put(UINT8 uart_ch, UINT8 tag, const UINT32 *word, UINT32 n, UINT32 *sum)
+{
+	UINT32 i, b;
+	UINT8 byte;
+
+	nos_uart_putc(uart_ch, tag);
+	*sum += tag;
+	for (i = 0; i < n; i++)
+	{
+		for (b = 0; b < 32; b += 8)
+		{
+			byte = (UINT8)(word[i] >> b);
+			nos_uart_putc(uart_ch, byte);
+			*sum += byte;
+		}
+	}
+}
+
+static void os_prof_put_heap(UINT8 uart_ch, UINT32 region, UINT32 *sum)
+{
+	TLSF_STATS s;
+	UINT32 rec[7];
+
+#ifdef HEAP_REGIONS
+	nos_heap_get_region_stats(region, &s);
+#else
+	nos_heap_get_stats(&s);
+#endif
+	rec[0] = region;
+	rec[1] = s.total;
+	rec[2] = s.used;
+	rec[3] = s.max_used;
+	rec[4] = s.free;
+	rec[5] = s.largest_free;
+	rec[6] = s.fail;
+	os_prof_put(uart_ch, HEAP_REC_HEAP, rec, 7, sum);
+}
+
+void heap_profile_dump(UINT8 uart_ch)
+{
+	HEAP_PROFILE_SUMMARY summary;
+	PROF_SITE site;
+	PROF_BLOCK block;
+	UINT32 rec[4], i, now_ms, sum = 0;
+	const char *magic = HEAP_REPORT_MAGIC;
+
+	while (*magic)
+	{
+		nos_uart_putc(uart_ch, *magic++);
+	}
+
+	heap_profile_get_summary(&summary);
+	now_ms = summary.now_ms;
+	os_prof_put(uart_ch, HEAP_REC_SUMMARY, (UINT32 *)&summary, sizeof(summary) / sizeof(UINT32), &sum);
+
+#ifdef HEAP_REGIONS
+	for (i = 0; i < MEM_REGIONS; i++)
+	{
+		os_prof_put_heap(uart_ch, i, &sum);
+	}
+#else
+	os_prof_put_heap(uart_ch, 0, &sum);
+#endif
+
+	for (i = 0; i < CONFIG_HEAP_PROFILE_SITES; i++)
+	{
+		NOS_ENTER_CRITICAL_SECTION();
+		site = os_prof_site[i];
+		NOS_EXIT_CRITICAL_SECTION();
+		if (site.allocs + site.alloc_fail != 0)
+		{
+			os_prof_put(uart_ch, HEAP_REC_SITE, (UINT32 *)&site, sizeof(site) / sizeof(UINT32), &sum);
+		}
+	}
+
+	for (i = 0; i < CONFIG_HEAP_PROFILE_BLOCKS; i++)
+	{
+		NOS_ENTER_CRITICAL_SECTION();
+		block = os_prof_block[i];
+		NOS_EXIT_CRITICAL_SECTION();
+		if (block.ptr != NULL)
+		{
+			rec[0] = (UINT32)(uintptr_t)block.ptr;
+			rec[1] = block.len;
+			rec[2] = os_prof_site[block.site].caller;
+			rec[3] = ((INT32)(now_ms - block.time_ms) > 0) ? now_ms - block.time_ms : 0;
+			os_prof_put(uart_ch, HEAP_REC_BLOCK, rec, 4, &sum);
+		}
+	}
+
+	rec[0] = sum;
+	os_prof_put(uart_ch, HEAP_REC_END, rec, 1, &sum);
+}
+
+#endif // HEAP_PROFILE
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2006-2015  Electronics and Telecommunications Research Institute (ETRI)
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file heap_profile.h
+ * @brief Heap profiler
+ * @ingroup
+ * @copyright GNU General Public License v3
+ *
+ * With HEAP_PROFILE nos_malloc() and nos_free() report every block here.
+ * A live block is kept with its length, the return address of the call
+ * that allocated it and the time of the allocation, and is counted for
+ * that call site. The tables are static: a block or a call site that does
+ * not fit is counted as untracked (or under a call site 0).
+ *
+ * heap_profile_dump() writes a binary report over a UART; on the host,
+ * tools/heap_report.py finds it in a capture of the output, symbolizes
+ * the call sites against the ELF file and prints the top allocators, the
+ * oldest live blocks and the fragmentation of each heap.
+ *
+ * Report: the magic "NHP1", then records made of a tag byte and a fixed
+ * number of little-endian UINT32 words:
+ *   HEAP_REC_SUMMARY	now_ms allocs frees alloc_fail untracked
+ *			live_count live_bytes peak_count peak_bytes
+ *   HEAP_REC_HEAP	region total used max_used free largest_free fail
+ *   HEAP_REC_SITE	caller allocs alloc_fail live_count live_bytes peak_bytes
+ *   HEAP_REC_BLOCK	ptr len caller age_ms
+ *   HEAP_REC_END	sum of the bytes between the magic and this record
+ * Each record is taken under the heap lock, so the report is consistent
+ * record by record but may move while it is written.
+ */
+
+#ifndef _HEAP_PROFILE_H_
+#define _HEAP_PROFILE_H_
+
+#include "kconf.h"
+#include "nos_common.h"
+
+#ifndef CONFIG_HEAP_PROFILE_BLOCKS
+#define CONFIG_HEAP_PROFILE_BLOCKS	256	// power of two
+#endif
+#ifndef CONFIG_HEAP_PROFILE_SITES
+#define CONFIG_HEAP_PROFILE_SITES	32
+#endif
+
+#define HEAP_REPORT_MAGIC	"NHP1"
+
+enum
+{
+	HEAP_REC_END,
+	HEAP_REC_SUMMARY,
+	HEAP_REC_HEAP,
+	HEAP_REC_SITE,
+	HEAP_REC_BLOCK
+};
+
+typedef struct _heap_profile_summary
+{
+	UINT32 now_ms;
+	UINT32 allocs;
+	UINT32 frees;
+	UINT32 alloc_fail;
+	UINT32 untracked;		// allocations the block table had no room for
+	UINT32 live_count;		// tracked live blocks
+	UINT32 live_bytes;		// ... and their requested bytes
+	UINT32 peak_count;
+	UINT32 peak_bytes;
+} HEAP_PROFILE_SUMMARY;
+
+/// From nos_malloc() (ptr NULL if it failed) and nos_free(), in the heap lock
+void os_heap_profile_alloc(void *ptr, UINT32 len, void *caller);
+void os_heap_profile_free(void *ptr);
+
+void heap_profile_get_summary(HEAP_PROFILE_SUMMARY *summary);
+/// Writes the binary report on the UART channel; not in ISR mode.
+void heap_profile_dump(UINT8 uart_ch);
+
+#endif // _HEAP_PROFILE_H_
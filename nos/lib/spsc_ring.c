@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2006-2015  Electronics and Telecommunications Research Institute (ETRI) 
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file spsc_ring.c
+ * @brief Lock-free single-producer/single-consumer byte ring
+ * @ingroup 
+ * @copyright GNU General Public License v3
+ */
+
+#include <string.h>
+#include "spsc_ring.h"
+
+BOOL spsc_ring_init(SPSC_RING *ring, UINT8 *buf, UINT32 size)
+{
+	if ((size == 0) || (size & (size - 1)))
+	{
+		return FALSE;
+	}
+
+	ring->head = 0;
+	ring->tail = 0;
+	ring->mask = size - 1;
+	ring->buf = buf;
+	return TRUE;
+}
+
+UINT32 spsc_ring_count(SPSC_RING *ring)
+{
+	UINT32 tail = nos_atomic_load(&ring->tail);
+
+	return nos_atomic_load_acquire(&ring->head) - tail;
+}
+
+UINT32 spsc_ring_space(SPSC_RING *ring)
+{
+	UINT32 head = nos_atomic_load(&ring->head);
+
+	return ring->mask + 1 - (head - nos_atomic_load_acquire(&ring->tail));
+}
+
+UINT32 spsc_ring_write_region(SPSC_RING *ring, UINT8 **ptr)
+{
+	UINT32 head = nos_atomic_load(&ring->head);
+	UINT32 space = ring->mask + 1 - (head - nos_atomic_load_acquire(&ring->tail));
+	UINT32 to_end = ring->mask + 1 - (head & ring->mask);
+
+	*ptr = ring->buf + (head & ring->mask);
+	return (space < to_end) ? space : to_end;
+}
+
+void spsc_ring_write_commit(SPSC_RING *ring, UINT32 len)
+{
+	nos_atomic_store_release(&ring->head, nos_atomic_load(&ring->head) + len);
+}
+
+UINT32 spsc_ring_read_region(SPSC_RING *ring, UINT8 **ptr)
+{
+	UINT32 tail = nos_atomic_load(&ring->tail);
+	UINT32 count = nos_atomic_load_acquire(&ring->head) - tail;
+	UINT32 to_end = ring->mask + 1 - (tail & ring->mask);
+
+	*ptr = ring->buf + (tail & ring->mask);
+	return (count < to_end) ? count : to_end;
+}
+
+void spsc_ring_read_release(SPSC_RING *ring, UINT32 len)
+{
+	nos_atomic_store_release(&ring->tail, nos_atomic_load(&ring->tail) + len);
+}
+
+UINT32 spsc_ring_push(SPSC_RING *ring, const void *data, UINT32 len)
+{
+	const UINT8 *src = data;
+	UINT32 done = 0, n;
+	UINT8 *ptr;
+
+	/* at most two regions: up to the end of the buffer, then from its start */
+	while ((done < len) && ((n = spsc_ring_write_region(ring, &ptr)) > 0))
+	{
+		if (n > len - done)
+		{
+			n = len - done;
+		}
+		memcpy(ptr, src + done, n);
+		spsc_ring_write_commit(ring, n);
+		done += n;
+	}
+
+	return done;
+}
+
+UINT32 spsc_ring_pop(SPSC_RING *ring, void *data, UINT32 len)
+{
+	UINT8 *dst = data;
+	UINT32 done = 0, n;
+	UINT8 *ptr;
+
+	while ((done < len) && ((n = spsc_ring_read_region(ring, &ptr)) > 0))
+	{
+		if (n > len - done)
+		{
+			n = len - done;
+		}
+		memcpy(dst + done, ptr, n);
+		spsc_ring_read_release(ring, n);
+		done += n;
+	}
+
+	return done;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2006-2015  Electronics and Telecommunications Research Institute (ETRI) 
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file spsc_ring.h
+ * @brief Lock-free single-producer/single-consumer byte ring
+ * @ingroup 
+ * @copyright GNU General Public License v3
+ *
+ * One context (e.g. an ISR) only writes, one other context (e.g. a thread)
+ * only reads, and neither masks interrupts. Each side owns one free-running
+ * index and publishes it with a release store after touching the data; the
+ * other side reads it with an acquire load (hal_atomic.h). The size is a
+ * power of two and every byte of it is usable.
+ *
+ * spsc_ring_write_region()/spsc_ring_read_region() give the largest
+ * contiguous free/filled area, e.g. to be filled or drained by DMA, which is
+ * then handed over with spsc_ring_write_commit()/spsc_ring_read_release().
+ */
+
+#ifndef _SPSC_RING_H_
+#define _SPSC_RING_H_
+
+#include "nos_common.h"
+#include "hal_atomic.h"
+
+typedef struct _spsc_ring
+{
+	NOS_ATOMIC_U32 head;	// bytes written so far (producer)
+	NOS_ATOMIC_U32 tail;	// bytes read so far (consumer)
+	UINT32 mask;		// size - 1
+	UINT8 *buf;
+} SPSC_RING;
+
+/// @p size must be a power of two. Returns FALSE otherwise.
+BOOL spsc_ring_init(SPSC_RING *ring, UINT8 *buf, UINT32 size);
+
+/// Producer: copies up to @p len bytes in, returns the number copied.
+UINT32 spsc_ring_push(SPSC_RING *ring, const void *data, UINT32 len);
+UINT32 spsc_ring_write_region(SPSC_RING *ring, UINT8 **ptr);
+void spsc_ring_write_commit(SPSC_RING *ring, UINT32 len);
+
+/// Consumer: copies up to @p len bytes out, returns the number copied.
+UINT32 spsc_ring_pop(SPSC_RING *ring, void *data, UINT32 len);
+UINT32 spsc_ring_read_region(SPSC_RING *ring, UINT8 **ptr);
+void spsc_ring_read_release(SPSC_RING *ring, UINT32 len);
+
+/// Bytes in the ring. Exact on the consumer side, a lower bound elsewhere.
+UINT32 spsc_ring_count(SPSC_RING *ring);
+/// Free bytes. Exact on the producer side, a lower bound elsewhere.
+UINT32 spsc_ring_space(SPSC_RING *ring);
+
+#endif // _SPSC_RING_H_
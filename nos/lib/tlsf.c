@@ -0,0 +1,354 @@
+/*
+ * Copyright (C) 2006-2015  Electronics and Telecommunications Research Institute (ETRI)
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file tlsf.c
+ * @brief Two-Level Segregated Fit memory allocator
+ * @ingroup
+ * @copyright GNU General Public License v3
+ */
+
+#include <string.h>
+#include "tlsf.h"
+
+#define TLSF_FREE		0x1U	// in size: the block is free
+#define TLSF_PREV_FREE		0x2U	// in size: the block below is free
+#define TLSF_FLAGS		(TLSF_FREE | TLSF_PREV_FREE)
+
+/* a free block holds its list links */
+#define TLSF_BLOCK_MIN		((UINT32)sizeof(TLSF_BLOCK) - TLSF_BLOCK_OVERHEAD)
+/* the largest size whose search class is still below 2^TLSF_FL_MAX */
+#define TLSF_BLOCK_MAX		((1U << TLSF_FL_MAX) - (1U << (TLSF_FL_MAX - 1 - TLSF_SL_LOG2)))
+
+#define TLSF_SIZE(b)		((b)->size & ~TLSF_FLAGS)
+#define TLSF_PTR(b)		((void *)((UINT8 *)(b) + TLSF_BLOCK_OVERHEAD))
+#define TLSF_HDR(p)		((TLSF_BLOCK *)((UINT8 *)(p) - TLSF_BLOCK_OVERHEAD))
+#define TLSF_NEXT(b)		((TLSF_BLOCK *)((UINT8 *)TLSF_PTR(b) + TLSF_SIZE(b)))
+
+#ifdef HEAP_TLSF_CHECK
+#define TLSF_TAG_USED		0xA110CA7EU
+#define TLSF_TAG_FREE		0xF4EEB10CU
+#define TLSF_GUARD_BYTES	4
+#define TLSF_GUARD		0xA5
+#endif
+
+static inline UINT32 tlsf_fls(UINT32 x)
+{
+	return 31 - __builtin_clz(x);
+}
+
+static inline UINT32 tlsf_ffs(UINT32 x)
+{
+	return __builtin_ctz(x);
+}
+
+/* list of a block size */
+static void tlsf_mapping(UINT32 size, UINT32 *fl, UINT32 *sl)
+{
+	UINT32 f;
+
+	if (size < TLSF_SMALL_BLOCK)
+	{
+		*fl = 0;
+		*sl = size >> TLSF_ALIGN_LOG2;
+	}
+	else
+	{
+		f = tlsf_fls(size);
+		*sl = (size >> (f - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+		*fl = f - (TLSF_FL_SHIFT - 1);
+	}
+}
+
+/* every block of the list of the result is at least size bytes */
+static UINT32 tlsf_round_up(UINT32 size)
+{
+	if (size >= TLSF_SMALL_BLOCK)
+	{
+		size += (1U << (tlsf_fls(size) - TLSF_SL_LOG2)) - 1;
+	}
+	return size;
+}
+
+static UINT32 tlsf_adjust(UINT32 len)
+{
+	UINT32 size;
+
+#ifdef HEAP_TLSF_CHECK
+	len += TLSF_GUARD_BYTES;
+#endif
+	size = (len + TLSF_ALIGN - 1) & ~(TLSF_ALIGN - 1);
+	return (size < TLSF_BLOCK_MIN) ? TLSF_BLOCK_MIN : size;
+}
+
+static void tlsf_insert(TLSF *tlsf, TLSF_BLOCK *block)
+{
+	UINT32 fl, sl;
+	TLSF_BLOCK *head;
+
+	tlsf_mapping(TLSF_SIZE(block), &fl, &sl);
+	head = tlsf->blocks[fl][sl];
+	block->next_free = head;
+	block->prev_free = NULL;
+	if (head != NULL)
+	{
+		head->prev_free = block;
+	}
+	tlsf->blocks[fl][sl] = block;
+	tlsf->fl_bitmap |= 1U << fl;
+	tlsf->sl_bitmap[fl] |= 1U << sl;
+	tlsf->free += TLSF_SIZE(block);
+#ifdef HEAP_TLSF_CHECK
+	block->tag = TLSF_TAG_FREE;
+#endif
+}
+
+static void tlsf_remove(TLSF *tlsf, TLSF_BLOCK *block)
+{
+	UINT32 fl, sl;
+
+	tlsf_mapping(TLSF_SIZE(block), &fl, &sl);
+	if (block->next_free != NULL)
+	{
+		block->next_free->prev_free = block->prev_free;
+	}
+	if (block->prev_free != NULL)
+	{
+		block->prev_free->next_free = block->next_free;
+	}
+	else
+	{
+		tlsf->blocks[fl][sl] = block->next_free;
+		if (block->next_free == NULL)
+		{
+			tlsf->sl_bitmap[fl] &= ~(1U << sl);
+			if (tlsf->sl_bitmap[fl] == 0)
+			{
+				tlsf->fl_bitmap &= ~(1U << fl);
+			}
+		}
+	}
+	tlsf->free -= TLSF_SIZE(block);
+}
+
+/* merges an allocated block with its free neighbours and lists it */
+static void tlsf_release(TLSF *tlsf, TLSF_BLOCK *block)
+{
+	TLSF_BLOCK *prev, *next = TLSF_NEXT(block);
+
+	if (block->size & TLSF_PREV_FREE)
+	{
+		prev = block->prev_phys;
+		tlsf_remove(tlsf, prev);
+		prev->size += TLSF_BLOCK_OVERHEAD + TLSF_SIZE(block);
+		block = prev;
+	}
+	if (next->size & TLSF_FREE)
+	{
+		tlsf_remove(tlsf, next);
+		block->size += TLSF_BLOCK_OVERHEAD + TLSF_SIZE(next);
+		next = TLSF_NEXT(block);
+	}
+	block->size |= TLSF_FREE;
+	next->prev_phys = block;
+	next->size |= TLSF_PREV_FREE;
+	tlsf_insert(tlsf, block);
+}
+
+#ifdef HEAP_TLSF_CHECK
+static BOOL tlsf_block_ok(TLSF_BLOCK *block)
+{
+	UINT8 *guard;
+	UINT32 i;
+
+	if ((block->tag != TLSF_TAG_USED) || (block->req + TLSF_GUARD_BYTES > TLSF_SIZE(block)))
+	{
+		return FALSE;
+	}
+	guard = (UINT8 *)TLSF_PTR(block) + block->req;
+	for (i = 0; i < TLSF_GUARD_BYTES; i++)
+	{
+		if (guard[i] != TLSF_GUARD)
+		{
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+#endif
+
+BOOL tlsf_add_pool(TLSF *tlsf, void *mem, UINT32 bytes)
+{
+	TLSF_BLOCK *block, *end;
+	UINT8 *start = (UINT8 *)(((uintptr_t)mem + TLSF_ALIGN - 1) & ~(uintptr_t)(TLSF_ALIGN - 1));
+
+	if (bytes < (UINT32)(start - (UINT8 *)mem) + 2 * TLSF_BLOCK_OVERHEAD + TLSF_BLOCK_MIN)
+	{
+		return FALSE;
+	}
+	bytes = (bytes - (UINT32)(start - (UINT8 *)mem)) & ~(TLSF_ALIGN - 1);
+	if (bytes > TLSF_BLOCK_MAX)
+	{
+		bytes = TLSF_BLOCK_MAX;
+	}
+
+	if ((tlsf->last != NULL) && (start == TLSF_PTR(tlsf->last)) && (tlsf->total + bytes <= TLSF_BLOCK_MAX))
+	{
+		/* right after the last pool: its end marker heads the new space */
+		block = tlsf->last;
+		block->size = (bytes - TLSF_BLOCK_OVERHEAD) | (block->size & TLSF_PREV_FREE);
+	}
+	else
+	{
+		block = (TLSF_BLOCK *)start;
+		block->prev_phys = NULL;
+		block->size = bytes - 2 * TLSF_BLOCK_OVERHEAD;
+	}
+
+	/* the end marker is an empty allocated block */
+	end = TLSF_NEXT(block);
+	end->prev_phys = block;
+	end->size = 0;
+#ifdef HEAP_TLSF_CHECK
+	end->tag = TLSF_TAG_USED;
+#endif
+	tlsf->last = end;
+	tlsf->total += bytes;
+
+	tlsf_release(tlsf, block);
+	return TRUE;
+}
+
+UINT32 tlsf_pool_size(UINT32 len)
+{
+	if (len > TLSF_BLOCK_MAX)
+	{
+		return 0;
+	}
+	return tlsf_round_up(tlsf_adjust(len)) + 2 * TLSF_BLOCK_OVERHEAD + TLSF_ALIGN;
+}
+
+void *tlsf_malloc(TLSF *tlsf, UINT32 len)
+{
+	TLSF_BLOCK *block, *rest, *next;
+	UINT32 size, fl, sl, map;
+
+	size = tlsf_adjust(len);
+	if ((len > TLSF_BLOCK_MAX) || (size > TLSF_BLOCK_MAX))
+	{
+		tlsf->fail++;
+		return NULL;
+	}
+
+	/* the first list of the size class or above that is not empty */
+	tlsf_mapping(tlsf_round_up(size), &fl, &sl);
+	map = tlsf->sl_bitmap[fl] & (~0U << sl);
+	if (map == 0)
+	{
+		map = tlsf->fl_bitmap & (~0U << (fl + 1));
+		if (map == 0)
+		{
+			tlsf->fail++;
+			return NULL;
+		}
+		fl = tlsf_ffs(map);
+		map = tlsf->sl_bitmap[fl];
+	}
+	sl = tlsf_ffs(map);
+	block = tlsf->blocks[fl][sl];
+	tlsf_remove(tlsf, block);
+
+	next = TLSF_NEXT(block);
+	if (TLSF_SIZE(block) >= size + sizeof(TLSF_BLOCK))
+	{
+		/* the rest becomes a free block */
+		rest = (TLSF_BLOCK *)((UINT8 *)TLSF_PTR(block) + size);
+		rest->prev_phys = block;
+		rest->size = (TLSF_SIZE(block) - size - TLSF_BLOCK_OVERHEAD) | TLSF_FREE;
+		next->prev_phys = rest;
+		block->size = size | (block->size & TLSF_PREV_FREE);
+		tlsf_insert(tlsf, rest);
+	}
+	else
+	{
+		block->size &= ~TLSF_FREE;
+		next->size &= ~TLSF_PREV_FREE;
+	}
+
+	tlsf->used += TLSF_BLOCK_OVERHEAD + TLSF_SIZE(block);
+	if (tlsf->used > tlsf->max_used)
+	{
+		tlsf->max_used = tlsf->used;
+	}
+
+#ifdef HEAP_TLSF_CHECK
+	block->tag = TLSF_TAG_USED;
+	block->req = len;
+	memset((UINT8 *)TLSF_PTR(block) + len, TLSF_GUARD, TLSF_GUARD_BYTES);
+#endif
+	return TLSF_PTR(block);
+}
+
+BOOL tlsf_free(TLSF *tlsf, void *ptr)
+{
+	TLSF_BLOCK *block;
+
+	if (ptr == NULL)
+	{
+		return TRUE;
+	}
+	block = TLSF_HDR(ptr);
+#ifdef HEAP_TLSF_CHECK
+	if (!tlsf_block_ok(block))
+	{
+		return FALSE;
+	}
+	/* before merging: the header stays behind when the block below takes it in */
+	block->tag = TLSF_TAG_FREE;
+#endif
+	tlsf->used -= TLSF_BLOCK_OVERHEAD + TLSF_SIZE(block);
+	tlsf_release(tlsf, block);
+	return TRUE;
+}
+
+UINT32 tlsf_block_size(void *ptr)
+{
+#ifdef HEAP_TLSF_CHECK
+	return TLSF_HDR(ptr)->req;
+#else
+	return TLSF_SIZE(TLSF_HDR(ptr));
+#endif
+}
+
+void tlsf_get_stats(TLSF *tlsf, TLSF_STATS *stats)
+{
+	TLSF_BLOCK *block;
+	UINT32 fl, sl;
+
+	stats->total = tlsf->total;
+	stats->used = tlsf->used;
+	stats->max_used = tlsf->max_used;
+	stats->free = tlsf->free;
+	stats->fail = tlsf->fail;
+	stats->largest_free = 0;
+
+	/* the largest block is in the highest list that is not empty */
+	if (tlsf->fl_bitmap != 0)
+	{
+		fl = tlsf_fls(tlsf->fl_bitmap);
+		sl = tlsf_fls(tlsf->sl_bitmap[fl]);
+		for (block = tlsf->blocks[fl][sl]; block != NULL; block = block->next_free)
+		{
+			if (TLSF_SIZE(block) > stats->largest_free)
+			{
+				stats->largest_free = TLSF_SIZE(block);
+			}
+		}
+	}
+}
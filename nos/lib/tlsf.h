@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2006-2015  Electronics and Telecommunications Research Institute (ETRI)
+ *
+ * This file is subject to the terms and conditions of the GNU General Public License V3
+ * See the file LICENSE in the top level directory for more details.
+ *
+ * This file is part of the NanoQplus3 operating system.
+ */
+
+/**
+ * @file tlsf.h
+ * @brief Two-Level Segregated Fit memory allocator
+ * @ingroup
+ * @copyright GNU General Public License v3
+ *
+ * Free blocks are kept in lists by size class: the first level is the
+ * power of two of the size, the second level splits it in TLSF_SL_COUNT
+ * linear steps. Two bitmaps tell which lists are not empty, so finding a
+ * block, splitting it and merging a freed block with its neighbours take a
+ * few bit scans and pointer updates whatever the heap looks like. The
+ * allocator does no locking; the caller serializes access.
+ *
+ * A zeroed TLSF is an empty heap; memory is given to it with
+ * tlsf_add_pool(). A pool placed right after the end of the previous one
+ * extends it, so a heap grown from sbrk stays one piece.
+ *
+ * With HEAP_TLSF_CHECK every block carries a tag and a guard after the
+ * requested length; tlsf_free() refuses a block whose tag or guard is
+ * wrong (double free, foreign pointer, overrun).
+ */
+
+#ifndef _TLSF_H_
+#define _TLSF_H_
+
+#include <stddef.h>
+#include "kconf.h"
+#include "nos_common.h"
+
+#define TLSF_ALIGN_LOG2		3
+#define TLSF_ALIGN		(1U << TLSF_ALIGN_LOG2)
+#define TLSF_SL_LOG2		4
+#define TLSF_SL_COUNT		(1U << TLSF_SL_LOG2)
+#define TLSF_FL_SHIFT		(TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_FL_MAX		24	// blocks below 16 MB
+#define TLSF_FL_COUNT		(TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+#define TLSF_SMALL_BLOCK	(1U << TLSF_FL_SHIFT)
+
+typedef struct _tlsf_block
+{
+	struct _tlsf_block *prev_phys;	// the block just below in memory
+	UINT32 size;			// payload bytes | TLSF_FREE | TLSF_PREV_FREE
+#ifdef HEAP_TLSF_CHECK
+	UINT32 tag;
+	UINT32 req;			// requested length, the guard follows it
+#endif
+	/* free blocks only, in the payload */
+	struct _tlsf_block *next_free;
+	struct _tlsf_block *prev_free;
+} TLSF_BLOCK;
+
+typedef struct _tlsf
+{
+	UINT32 fl_bitmap;
+	UINT32 sl_bitmap[TLSF_FL_COUNT];
+	TLSF_BLOCK *blocks[TLSF_FL_COUNT][TLSF_SL_COUNT];
+	TLSF_BLOCK *last;		// end marker of the last pool
+	UINT32 total;			// bytes given by tlsf_add_pool()
+	UINT32 used;			// allocated blocks, headers included
+	UINT32 max_used;
+	UINT32 free;			// payload bytes of the free blocks
+	UINT32 fail;			// tlsf_malloc() calls that found no block
+} TLSF;
+
+typedef struct _tlsf_stats
+{
+	UINT32 total;
+	UINT32 used;
+	UINT32 max_used;
+	UINT32 free;
+	UINT32 largest_free;
+	UINT32 fail;
+} TLSF_STATS;
+
+/// Header bytes of a block
+#define TLSF_BLOCK_OVERHEAD	((UINT32)offsetof(TLSF_BLOCK, next_free))
+
+/// Adds mem as a pool. Returns FALSE if it is too small.
+BOOL tlsf_add_pool(TLSF *tlsf, void *mem, UINT32 bytes);
+/// Pool bytes that are sure to serve tlsf_malloc(len)
+UINT32 tlsf_pool_size(UINT32 len);
+
+void *tlsf_malloc(TLSF *tlsf, UINT32 len);
+/// Returns FALSE if ptr is not a valid allocated block (checks enabled).
+BOOL tlsf_free(TLSF *tlsf, void *ptr);
+/// Usable bytes of an allocated block
+UINT32 tlsf_block_size(void *ptr);
+
+/// largest_free walks one list; the other fields are counters.
+void tlsf_get_stats(TLSF *tlsf, TLSF_STATS *stats);
+
+#endif // _TLSF_H_
@@ -0,0 +1,74 @@
+//===================================================================
+//
+// linux_sim_it.c
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+// Exception handlers of the Linux host simulator, the counterpart of
+// stm32f4xx_it.c. They are entered from the tick signal handler in
+// nos/arch/posix/hal_sched.c with the tick signal blocked.
+
+#include <stdio.h>
+#include <nos.h>
+#include "kconf.h"
+#include "platform.h"
+
+#ifdef KERNEL_M
+#include "thread.h"
+#include "sched.h"
+#include "hal_sched.h"
+extern THREAD *highest_thread;
+extern THREAD *current_thread;
+#endif
+
+volatile UINT32 global_os_counter;
+
+__IO uint32_t SysTick_CNT = 0;
+__IO uint32_t TIM2_CNT = 0;
+__IO uint32_t MeasureTimer_CNT = 0;
+
+#ifdef KERNEL_M
+
+/**
+  * @brief  This function handles PendSV_Handler exception.
+  *         The tick signal is blocked for the whole handler, as PRIMASK is
+  *         set on the MCU, so no explicit interrupt masking is done here.
+  */
+void PendSV_Handler(void)
+{
+	NOS_CTX_SW_PENDING_CLEAR();
+	if (highest_thread != current_thread)
+	{
+		THREAD *prev_thread = current_thread;
+
+		os_sched_switch_hook(prev_thread, highest_thread);
+		current_thread = highest_thread;
+		os_switch_context(prev_thread, current_thread);	// returns when prev_thread is resumed
+	}
+}
+
+/**
+  * @brief  This function handles SysTick Handler.
+  *         The scheduler runs only when the programmed tick is reached, and
+  *         PendSV is pended only when another thread became the highest.
+  */
+void SysTick_Handler(void)
+{
+	if (!os_timer_tick_isr()) {
+		return;
+	} // end if
+
+	global_os_counter++;
+	SysTick_CNT++;
+
+	if (sched_callback) {
+		sched_callback();
+	} // end if
+
+	if (highest_thread != current_thread) {
+		NOS_CTX_SW_PENDING_SET();
+	} // end if
+} // end func
+
+#endif
@@ -0,0 +1,83 @@
+// -*- c-file-style:"bsd"; c-basic-offset:4; indent-tabs-mode:nil; -*-
+/*
+ * Copyright (c) 2013
+ * Electronics and Telecommunications Research Institute (ETRI)
+ * All Rights Reserved.
+ *
+ * Following acts are STRICTLY PROHIBITED except when a specific prior written
+ * permission is obtained from ETRI or a separate written agreement with ETRI
+ * stipulates such permission specifically:
+ *
+ * a) Selling, distributing, sublicensing, renting, leasing, transmitting,
+ * redistributing or otherwise transferring this software to a third party;
+ *
+ * b) Copying, transforming, modifying, creating any derivatives of, reverse
+ * engineering, decompiling, disassembling, translating, making any attempt to
+ * discover the source code of, the whole or part of this software in source or
+ * binary form;
+ *
+ * c) Making any copy of the whole or part of this software other than one copy
+ * for backup purposes only; and
+ *
+ * d) Using the name, trademark or logo of ETRI or the names of contributors in
+ * order to endorse or promote products derived from this software.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITHOUT A WARRANTY OF ANY KIND. ALL
+ * EXPRESS OR IMPLIED CONDITIONS, REPRESENTATIONS AND WARRANTIES, INCLUDING ANY
+ * IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE OR
+ * NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI (OR ITS
+ * LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR
+ * DIRECT, INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES,
+ * HOWEVER CAUSED AND REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE USE OF OR INABILITY TO USE THIS SOFTWARE, EVEN
+ * IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * Any permitted redistribution of this software must retain the copyright
+ * notice, conditions, and disclaimer as specified above.
+ */
+
+/**
+ * Linux host simulator platform
+ */
+
+#include "kconf.h"
+
+#include <stdio.h>
+#include "nos_common.h"
+#include "platform.h"
+#include "nos_timer.h"
+#include "vtime.h"
+
+
+void nos_platform_init(void)
+{
+#ifdef UART_M
+#ifdef UART1
+    nos_uart_init(0);
+#endif
+#endif
+}
+
+/*
+ * Busy-wait like the MCU version: the delay must work inside critical
+ * sections and handlers, where the tick signal is blocked. On virtual time
+ * the delay is the running thread's CPU time; it advances the clock instead.
+ */
+void nos_delay_us(uint32_t us)
+{
+#ifdef SIM_VIRTUAL_TIME
+    nos_vtime_advance(us);
+#else
+    uint64_t end = nos_timer_host_us() + us;
+
+    while (nos_timer_host_us() < end)
+    {
+        ;
+    }
+#endif
+}
+
+void nos_delay_ms(uint32_t ms)
+{
+    nos_delay_us(ms * 1000);
+}
@@ -0,0 +1,82 @@
+// -*- c-file-style:"bsd"; c-basic-offset:4; indent-tabs-mode:nil; -*-
+/*
+ * Copyright (c) 2013
+ * Electronics and Telecommunications Research Institute (ETRI)
+ * All Rights Reserved.
+ *
+ * Following acts are STRICTLY PROHIBITED except when a specific prior written
+ * permission is obtained from ETRI or a separate written agreement with ETRI
+ * stipulates such permission specifically:
+ *
+ * a) Selling, distributing, sublicensing, renting, leasing, transmitting,
+ * redistributing or otherwise transferring this software to a third party;
+ *
+ * b) Copying, transforming, modifying, creating any derivatives of, reverse
+ * engineering, decompiling, disassembling, translating, making any attempt to
+ * discover the source code of, the whole or part of this software in source or
+ * binary form;
+ *
+ * c) Making any copy of the whole or part of this software other than one copy
+ * for backup purposes only; and
+ *
+ * d) Using the name, trademark or logo of ETRI or the names of contributors in
+ * order to endorse or promote products derived from this software.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS," WITHOUT A WARRANTY OF ANY KIND. ALL
+ * EXPRESS OR IMPLIED CONDITIONS, REPRESENTATIONS AND WARRANTIES, INCLUDING ANY
+ * IMPLIED WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE OR
+ * NON-INFRINGEMENT, ARE HEREBY EXCLUDED. IN NO EVENT WILL ETRI (OR ITS
+ * LICENSORS, IF ANY) BE LIABLE FOR ANY LOST REVENUE, PROFIT OR DATA, OR FOR
+ * DIRECT, INDIRECT, SPECIAL, CONSEQUENTIAL, INCIDENTAL OR PUNITIVE DAMAGES,
+ * HOWEVER CAUSED AND REGARDLESS OF THE THEORY OF LIABILITY, ARISING FROM, OUT
+ * OF OR IN CONNECTION WITH THE USE OF OR INABILITY TO USE THIS SOFTWARE, EVEN
+ * IF ETRI HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+ *
+ * Any permitted redistribution of this software must retain the copyright
+ * notice, conditions, and disclaimer as specified above.
+ */
+
+/**
+ * Linux host simulator platform
+ *
+ * The whole node runs in one host process on top of the "posix" MCU port.
+ * SYSCLK/PCLK1 only keep code written for the MCU clock tree compiling.
+ */
+
+#ifndef PLATFORM_H_
+#define PLATFORM_H_
+
+#include "kconf.h"
+#include "nos_common.h"
+
+/*ARCH(SYSTEM)*/
+#define SYSCLK 168000000
+#define HCLK   168000000
+#define PCLK1   42000000
+#define PCLK2   84000000
+
+
+/*TIMER channel usage*/
+#define WPAN_DEV0_TIMER 0   //ed scan, wpan_dev_transmit
+#define WPAN_DEV1_TIMER 1
+#define WPAN_MAC_TIMER  2   //for indirect data transmit, active scan
+#define PING6_TIMER  3   //ping
+
+
+#ifdef UART_M
+#include "uart.h"
+#endif
+
+
+void nos_platform_init(void);
+/**
+ * Delay @p us microseconds.
+ */
+void nos_delay_us(uint32_t us);
+
+/**
+ * Delay @p ms milliseconds.
+ */
+void nos_delay_ms(uint32_t ms);
+
+#endif //PLATFORM_H_
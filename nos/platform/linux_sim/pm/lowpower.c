@@ -0,0 +1,103 @@
+
+#include "lowpower.h"
+#include "pwmgmt.h"
+#include "vtime.h"
+
+// The host has no low power states. Every mode waits for the next tick
+// signal, which is what the MCU modes boil down to from the kernel's point
+// of view: the tick timer stays programmed for the next tick_q expiry.
+
+UINT32 actual_idle_tick;
+
+// to register system save callback function
+UINT32 (*callback_save_standby)(UINT32);
+UINT32 (*callback_save_pwroff)(UINT32);
+
+
+// classifies an idle period of delta ticks
+//
+static UINT32 lp_classify_idle(UINT32 delta) {
+
+#if PWRMODE_IDLE_THRESHOLD != 0
+	if (delta < PWRMODE_IDLE_THRESHOLD / 10) {
+		return IDLE_MODE;
+	} // end if
+#endif // PWRMODE_IDLE_THRESHOLD
+
+#if PWRMODE_SLEEP_THRESHOLD != 0
+	if (delta < PWRMODE_SLEEP_THRESHOLD / 10) {
+		return SLEEP_MODE;
+	} // end if
+#endif // PWRMODE_SLEEP_THRESHOLD
+
+#if PWRMODE_STOP_THRESHOLD != 0
+	if (delta < PWRMODE_STOP_THRESHOLD / 10) {
+		return STOP_MODE;
+	} // end if
+#endif // PWRMODE_STOP_THRESHOLD
+
+#if PWRMODE_STANDBY_THRESHOLD != 0
+	if (delta < PWRMODE_STANDBY_THRESHOLD / 10) {
+		return STANDBY_MODE;
+	} // end if
+#endif // PWRMODE_STANDBY_THRESHOLD
+
+#if PWRMODE_PWROFF_THRESHOLD != 0
+	if (delta < PWRMODE_PWROFF_THRESHOLD / 10) {
+		return POWEROFF_MODE;
+	} // end if
+#endif // PWRMODE_PWROFF_THRESHOLD
+
+	return IDLE_MODE;
+} // end func
+
+// returns low power idle mode
+//
+UINT32 lp_get_idle_mode(UINT32 delta) {
+	UINT32 mode = lp_classify_idle(delta);
+
+#ifdef SIM_VIRTUAL_TIME
+	// The mode is only accounted. A spinning idle thread would never let
+	// virtual time advance, so every idle period waits for the tick.
+	nos_vtime_idle_mode(mode);
+	if (mode == IDLE_MODE) {
+		mode = SLEEP_MODE;
+	} // end if
+#endif
+
+	return mode;
+} // end func
+
+void lp_enter_sleep_mode(UINT32 delta) {
+	__WFI();
+} // end func
+
+void lp_enter_stop_mode(UINT32 delta) {
+	__WFI();
+} // end func
+
+void lp_enter_standby_mode(UINT32 delta) {
+	__WFI();
+} // end func
+
+void lp_enter_pwroff_mode(UINT32 delta) {
+	__WFI();
+} // end func
+
+UINT32 register_callback_save_standby(UINT32(*func)(UINT32)) {
+	
+	if (func) {
+		callback_save_standby = func;
+	} // end if
+	
+	return 0;
+} // end func
+
+UINT32 register_callback_save_pwroff(UINT32(*func)(UINT32)) {
+
+	if (func) {
+		callback_save_pwroff = func;
+	} // end if
+	
+	return 0;
+} // end func
@@ -0,0 +1,7 @@
+#ifndef POWER_MANAGEMENT_H
+#define POWER_MANAGEMENT_H
+
+// The host simulator has no clock tree or power domains to manage.
+// This header exists because the kernel includes it unconditionally.
+
+#endif
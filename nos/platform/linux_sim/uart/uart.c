@@ -0,0 +1,124 @@
+//===================================================================
+//
+// uart.c
+//
+//===================================================================
+// Copyright 2016-2025, ETRI
+//===================================================================
+// UART of the Linux host simulator. Every channel is mapped to the
+// process' stdin/stdout. Output goes through write(2) rather than
+// stdio: a thread may be preempted by the tick signal in the middle of
+// a call, and stdio buffers are not safe to re-enter from another thread.
+
+#include "uart.h"
+#ifdef UART_M
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "platform.h"
+#include "arch.h"
+
+static void (*nos_uart_rx_callback)(uint8_t uart_ch, uint8_t data);
+
+static void nos_uart_write(const char *buf, size_t len)
+{
+	ssize_t n;
+
+	while (len > 0)
+	{
+		n = write(STDOUT_FILENO, buf, len);
+		if (n <= 0)
+		{
+			return;
+		}
+		buf += n;
+		len -= n;
+	}
+}
+
+void nos_uart_init(uint8_t uart_ch)
+{
+	nos_uart_rx_callback = NULL;
+}
+
+void nos_uart_putc(uint8_t uart_ch, const uint8_t data)
+{
+	nos_uart_write((const char *)&data, 1);
+}
+
+void nos_uart_puts(UINT8 port_num, const char *str)
+{
+	nos_uart_write(str, strlen(str));
+}
+
+void nos_uart_puti(UINT8 port_num, int val)
+{
+	char buf[12];
+
+	nos_uart_write(buf, snprintf(buf, sizeof(buf), "%d", val));
+}
+
+void nos_uart_putu(UINT8 port_num, int val)
+{
+	char buf[12];
+
+	nos_uart_write(buf, snprintf(buf, sizeof(buf), "%u", (unsigned)val));
+}
+
+uint8_t nos_uart_getc(uint8_t uart_ch)
+{
+	uint8_t data = 0;
+
+	if (read(STDIN_FILENO, &data, 1) != 1)
+	{
+		return 0;
+	}
+	return data;
+}
+
+void uart_printf(const char *msg, ...)
+{
+	char buf[256];
+	va_list ap;
+	int len;
+
+	va_start(ap, msg);
+	len = vsnprintf(buf, sizeof(buf), msg, ap);
+	va_end(ap);
+
+	if (len > (int)sizeof(buf) - 1)
+	{
+		len = sizeof(buf) - 1;
+	}
+	if (len > 0)
+	{
+		nos_uart_write(buf, len);
+	}
+}
+
+int nos_uart_set_rx_callback(uint8_t uart_ch, void (*func)(uint8_t uart_ch, uint8_t data))
+{
+	nos_uart_rx_callback = func;
+	return EXIT_SUCCESS;
+}
+
+// There is no receive interrupt on the host.
+int nos_uart_enable_rx_intr(uint8_t uart_ch)
+{
+	return EXIT_FAIL;
+}
+
+int nos_uart_disable_rx_intr(uint8_t uart_ch)
+{
+	return EXIT_SUCCESS;
+}
+
+bool nos_uart_rx_intr_is_set(uint8_t uart_ch)
+{
+	return FALSE;
+}
+
+#endif // UART_M
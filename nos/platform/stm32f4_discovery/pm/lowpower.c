@@ -286,13 +286,14 @@ UINT32 lp_get_idle_mode(UINT32 delta) {
 
 void lp_enter_sleep_mode(UINT32 delta) {
 
-// FIXME : sleep mode still has tick (10msec)
+	// Every tick wakes the MCU up. With SCHED_TICKLESS the tick timer is
+	// one-shot: SLEEP mode is left at the next tick_q expiry, and the SysTick
+	// wraps in between (every 100msec at most) only update the time base and
+	// do not run the scheduler.
 
 	set_power_mode(PWR_SLEEP_MODE, FREQ_STAYING, PERI_STAYING);
 } // end func
 
-extern UINT32 SysTick_Reload_OverFlow;
-
 void lp_enter_stop_mode(UINT32 delta) {
 
 	//UINT32 rtc_time;
@@ -309,10 +310,10 @@ void lp_enter_stop_mode(UINT32 delta) {
 
 	set_power_mode(PWR_STOP_LowPwrRegFlashPwrDown, FREQ_STAYING, PERI_STAYING);
 
-	//__gcounter += delta * 10;
-
 	SYSCLKConfig_STOP();
-	SysTick_Reload_OverFlow = 0;
+
+	// SysTick was stopped: account the sleep timed by the RTC
+	os_timer_tick_credit(delta);
 
 	os_timer_tick_set(0);
 } // end func
@@ -391,7 +392,6 @@ here1:
 
 	NOS_ENABLE_GLOBAL_INTERRUPT();
 	SYSCLKConfig_STOP();
-	SysTick_Reload_OverFlow = 0;
 
 	RTC_Configuration(1);
 	RTC_WakeUpCmd(ENABLE);
@@ -465,7 +465,6 @@ here2:
 
 	NOS_ENABLE_GLOBAL_INTERRUPT();
 	SYSCLKConfig_STOP();
-	SysTick_Reload_OverFlow = 0;
 
 	RTC_Configuration(1);
 	RTC_WakeUpCmd(ENABLE);
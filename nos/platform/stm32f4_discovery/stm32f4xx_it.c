@@ -36,11 +36,6 @@ extern THREAD *current_thread;
 
 volatile UINT32 global_os_counter;
 
-extern DQUEUE tick_q;
-extern UINT32 Tick_Period;
-extern UINT32 Remain_Tick_Value;
-extern UINT32 SysTick_Reload_OverFlow;
-
 extern UINT32 __gcounter;
 
 /** @addtogroup STM32F4_Discovery_Peripheral_Examples
@@ -55,7 +50,8 @@ extern UINT32 __gcounter;
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-__IO uint32_t TimingDelay = 0;
+__IO uint32_t TimingDelay = 0;		// counts down in msec
+static uint32_t TimingDelay_ms;		// time base at its last update
 __IO uint8_t UserButtonStatus= 0x00;
 __IO uint32_t SysTick_CNT = 0;
 __IO uint32_t TIM2_CNT = 0;
@@ -255,6 +251,7 @@ void PendSV_Handler(void)
 	 {
 		THREAD *prev_thread = current_thread;
 			
+		os_sched_switch_hook(prev_thread, highest_thread);
 		current_thread = highest_thread;
    		os_switch_context(prev_thread, current_thread);   // may return here with global interrupt SET
 	 }
@@ -263,18 +260,28 @@ void PendSV_Handler(void)
 
 /**
   * @brief  This function handles SysTick Handler.
+  *         SysTick is one-shot (see os_timer_tick_set()): the scheduler runs
+  *         only when the programmed tick is reached, and PendSV is pended
+  *         only when that made another thread the highest.
   * @param  None
   * @retval None
   * @phj
   */
 void SysTick_Handler(void) {
 
-	UINT32 SysTickCTRL;
-	//UINT32 SysTickCTRL, j = 0;
-	//DNODE *dnode = tick_q.head;
-	TimingDelay--;
+	BOOL reached;
+	uint32_t now_ms;
+
+	OS_ENTER_ISR();
+	reached = os_timer_tick_isr();
+
+	// the SysTick period varies (tickless mode, long periods without a
+	// deadline), so TimingDelay follows the time base, not the interrupts
+	now_ms = (uint32_t)(os_timer_time_us() / 1000);
+	TimingDelay -= now_ms - TimingDelay_ms;
+	TimingDelay_ms = now_ms;
 
-	if (SysTick_Reload_OverFlow == 0) {
+	if (reached) {
 
 		NOS_DISABLE_GLOBAL_INTERRUPT();
 		
@@ -284,75 +291,26 @@ void SysTick_Handler(void) {
 			sched_callback();
 		} // end if
 
-
 		SysTick_CNT++;
-		//__gcounter += 11;
 
 		NOS_ENABLE_GLOBAL_INTERRUPT();
 
-		NOS_CTX_SW_PENDING_SET();
-
-	} else {
-
-		SysTickCTRL = SysTick->CTRL;
-
-		if (Tick_Period != 0) {
-			if ((SysTickCTRL & SysTick_CTRL_COUNTFLAG_Msk) == 0x10000) {
-				Tick_Period--;
-				SysTick->LOAD = MAX_SYSTICK_VALUE;
-				SysTick->VAL = 0;
-				SysTick_CNT++;
-				//__gcounter += 99;
-
-				NOS_CTX_SW_PENDING_SET();
-			} // end if
-		} else {
-			if ((Tick_Period == 0) && ((SysTickCTRL & SysTick_CTRL_COUNTFLAG_Msk) == 0x10000)) {
-				if (Remain_Tick_Value != 0) {
-					SysTick_Reload_OverFlow = 0;
-					SysTick->LOAD = Remain_Tick_Value * TICK_UNIT;
-					SysTick->VAL = 0;
-
-					SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
-					SysTick_CNT++;
-
-					//FIXME
-					//__gcounter += Remain_Tick_Value;
-
-					NOS_CTX_SW_PENDING_SET();
-				} else {
-					SysTick_Reload_OverFlow = 0;
-					SysTick->LOAD = (TICK_UNIT * 10); // 10msec
-					SysTick->VAL = 0;
-					
-					SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
-
-					NOS_DISABLE_GLOBAL_INTERRUPT();
-
-					global_os_counter++;
-
-					if (sched_callback) {
-						sched_callback();
-					} // end if
-
-					//__gcounter += 11;
-
-					NOS_ENABLE_GLOBAL_INTERRUPT();
-
-					NOS_CTX_SW_PENDING_SET();
-				} // end if
-			} // end if
+		if (highest_thread != current_thread) {
+			NOS_CTX_SW_PENDING_SET();
 		} // end if
 	} // end if
+	OS_EXIT_ISR();
 } // end func
 
 void TIM5_IRQHandler(void)
 {
+    OS_ENTER_ISR();
     if(TIM_GetITStatus(TIM5,TIM_IT_Update) != RESET)
     {
         TIM_ClearITPendingBit(TIM5, TIM_IT_Update); // Clear the interrupt flag
     }
     MeasureTimer_CNT++;
+    OS_EXIT_ISR();
 }
 
 #endif
@@ -387,6 +345,7 @@ void RTC_WKUP_IRQHandler(void)
   */
 void EXTI0_IRQHandler(void)
 {
+  OS_ENTER_ISR();
   if (EXTI_GetITStatus(EXTI_Line0) != RESET)
   {
     /* Clear the user push-button EXTI line pending bit */
@@ -396,11 +355,25 @@ void EXTI0_IRQHandler(void)
     nos_button_isr(BUTTON_USER);
 #endif
   }
+  OS_EXIT_ISR();
 }
 #ifdef KERNEL_M
 
 void TIM2_IRQHandler(void) {
+	OS_ENTER_ISR();
 	TIM2_CNT++; // @phj.
+#ifdef HRTIMER_M
+	if (TIM_GetITStatus(TIM2, TIM_IT_CC1) != RESET) {
+		TIM_ClearITPendingBit(TIM2, TIM_IT_CC1);
+
+		os_hrtimer_isr();
+
+		if (highest_thread != current_thread) {
+			NOS_CTX_SW_PENDING_SET();
+		} // end if
+	} // end if
+#endif
+	OS_EXIT_ISR();
 #if 0
    if(TIM_GetITStatus(TIM2, TIM_IT_Update) != RESET)
    {
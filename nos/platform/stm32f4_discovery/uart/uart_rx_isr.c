@@ -132,6 +132,7 @@ bool nos_uart_rx_intr_is_set(uint8_t uart_ch)
 void USART1_IRQHandler(void)
 {
     UINT16 st;
+    OS_ENTER_ISR();
     st = USART1->SR;
     while (st & (USART_FLAG_RXNE | USART_FLAG_ERRORS))
     {
@@ -143,12 +144,14 @@ void USART1_IRQHandler(void)
         }
         st = USART1->SR;
     }
+    OS_EXIT_ISR();
 }
 
 
 void USART2_IRQHandler(void)
 {
     UINT16 st;
+    OS_ENTER_ISR();
     st = USART2->SR;
     while (st & (USART_FLAG_RXNE | USART_FLAG_ERRORS))
     {
@@ -160,6 +163,7 @@ void USART2_IRQHandler(void)
         }
         st = USART2->SR;
     }
+    OS_EXIT_ISR();
 }
 
 
@@ -0,0 +1,131 @@
+//========================================================================
+// File		: mutex_bench.c
+// Description : Worst-case mutex lock latency with mixed-priority
+//		 contenders. A CPU hog that never touches the mutex runs
+//		 between the low and the high priority users; without priority
+//		 inheritance it stretches the wait of the high priority thread
+//		 up to its own burst. mutex_lock_timeout() is exercised too.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+#define BENCH_ROUNDS	200
+#define HOLD_LOW_US	2000	// critical section of the low priority user
+#define WORK_LOW_US	1000	// ... and its work outside of it
+#define HOLD_NORMAL_US	500
+#define HOG_BURST_MS	30	// medium priority work, no mutex
+#define NORMAL_TIMEOUT	2	// ticks
+
+UINT32 tid_low, tid_normal, tid_hog, tid_high;
+UINT32 res;
+
+typedef struct
+{
+	UINT32 n;
+	UINT32 timeouts;
+	UINT32 max_us;
+	uint64_t sum_us;
+} LAT_STAT;
+
+LAT_STAT lat_normal, lat_high;
+
+static void lat_add(LAT_STAT *s, UINT64 t0)
+{
+	UINT32 us = (UINT32)(os_time_get_us() - t0);
+
+	s->n++;
+	s->sum_us += us;
+	if (us > s->max_us)
+	{
+		s->max_us = us;
+	}
+}
+
+static void lat_print(const char *name, LAT_STAT *s)
+{
+	uart_printf("%-7s: %4u locks, %3u timeouts, avg %5u us, max %5u us\n",
+		    name, s->n, s->timeouts, (UINT32)(s->n ? s->sum_us / s->n : 0), s->max_us);
+}
+
+void low_task(void *args)
+{
+	while (1)
+	{
+		mutex_lock(res);
+		nos_delay_us(HOLD_LOW_US);
+		mutex_unlock(res);
+		nos_delay_us(WORK_LOW_US);	// never sleeps, so the lock is taken off the tick grid
+	}
+}
+
+void normal_task(void *args)
+{
+	UINT64 t0;
+
+	while (1)
+	{
+		t0 = os_time_get_us();
+		if (mutex_lock_timeout(res, NORMAL_TIMEOUT) == E_TIMEOUT)
+		{
+			lat_normal.timeouts++;
+		}
+		else
+		{
+			lat_add(&lat_normal, t0);
+			nos_delay_us(HOLD_NORMAL_US);
+			mutex_unlock(res);
+		}
+		thread_sleep(3);
+	}
+}
+
+void hog_task(void *args)
+{
+	while (1)
+	{
+		thread_sleep(7);
+		nos_delay_ms(HOG_BURST_MS);
+	}
+}
+
+void high_task(void *args)
+{
+	UINT32 i;
+	UINT64 t0;
+
+	uart_printf("Mutex lock latency (%u rounds, low holds %u us, hog bursts %u ms)\n",
+		    BENCH_ROUNDS, HOLD_LOW_US, HOG_BURST_MS);
+
+	for (i = 0; i < BENCH_ROUNDS; i++)
+	{
+		thread_sleep(2 + i % 4);
+
+		t0 = os_time_get_us();
+		mutex_lock(res);
+		lat_add(&lat_high, t0);
+		mutex_unlock(res);
+	}
+
+	thread_terminate(tid_low);
+	thread_terminate(tid_normal);
+	thread_terminate(tid_hog);
+
+	lat_print("high", &lat_high);
+	lat_print("normal", &lat_normal);
+}
+
+void app_init(void)
+{
+	mutex_create(&res, NO_CEILING);
+
+	thread_create(low_task, NULL, 0, PRIORITY_LOW, FIFO, &tid_low);
+	thread_create(normal_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_normal);
+	thread_create(hog_task, NULL, 0, PRIORITY_HIGH, FIFO, &tid_hog);
+	thread_create(high_task, NULL, 0, PRIORITY_HIGHEST, FIFO, &tid_high);
+
+	thread_activate(tid_low);
+	thread_activate(tid_normal);
+	thread_activate(tid_hog);
+	thread_activate(tid_high);
+}
@@ -0,0 +1,80 @@
+//========================================================================
+// File		: sem_ex.c
+// Description : Counting semaphore. An alarm (tick ISR) posts a burst of
+//		 items; consumers of different priorities take them in
+//		 priority order, a low priority one gives up after a timeout.
+//		 A binary semaphore signals the end of each burst.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+UINT32 tid_high, tid_normal, tid_low, tid_report;
+UINT32 alid;
+UINT32 items, done;
+UINT32 got[3], timeouts;
+
+// ISR mode
+void producer(UINT32 n)
+{
+	UINT32 i;
+
+	for (i = 0; i < n; i++)
+	{
+		sem_post(items);
+	}
+	sem_post(done);
+}
+
+void consumer(void *args)
+{
+	UINT32 id = (UINT32)args;
+
+	while (1)
+	{
+		if (id == 2) // the low priority one does not wait long
+		{
+			if (sem_wait_timeout(items, 50) == E_TIMEOUT)
+			{
+				timeouts++;
+				continue;
+			}
+		}
+		else
+		{
+			sem_wait(items);
+		}
+		got[id]++;
+		delay_ms(1); // let the others queue up behind
+	}
+}
+
+void report(void *args)
+{
+	while (1)
+	{
+		sem_wait(done);
+		thread_sleep(SEC(1) / 2);
+		uart_printf("high %u, normal %u, low %u (%u timeouts), left %u\n",
+			    got[0], got[1], got[2], timeouts, sem_get_count(items));
+	}
+}
+
+void app_init(void)
+{
+	sem_create(&items, 0, SEM_COUNTING);
+	sem_create(&done, 0, SEM_BINARY);
+
+	thread_create(consumer, (void *)0, 0, PRIORITY_HIGH, FIFO, &tid_high);
+	thread_create(consumer, (void *)1, 0, PRIORITY_NORMAL, FIFO, &tid_normal);
+	thread_create(consumer, (void *)2, 0, PRIORITY_LOW, FIFO, &tid_low);
+	thread_create(report, NULL, 0, PRIORITY_HIGHEST, FIFO, &tid_report);
+
+	thread_activate(tid_high);
+	thread_activate(tid_normal);
+	thread_activate(tid_low);
+	thread_activate(tid_report);
+
+	alarm_create(producer, 10, SEC(1), SEC(1), &alid);
+	alarm_start(alid);
+}
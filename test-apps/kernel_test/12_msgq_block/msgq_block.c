@@ -0,0 +1,61 @@
+//========================================================================
+// File		: msgq_block.c
+// Description : Blocking message queue with 3-word messages. The producer
+//		 sends bursts and blocks while the queue is full; the consumer
+//		 blocks while it is empty and reports the gaps with a timeout.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+#define MSG_WORDS	3
+#define BURST		10
+
+UINT32 mqid;
+UINT32 tid_prod, tid_cons;
+
+void producer(void *args)
+{
+	UINT32 msg[MSG_WORDS];
+	UINT32 seq = 0, i;
+
+	while (1)
+	{
+		for (i = 0; i < BURST; i++)
+		{
+			msg[0] = seq++;
+			msg[1] = (UINT32)os_tick_get();
+			msg[2] = msg[0] * msg[0];
+			msgq_send_timeout(mqid, msg, WAIT_FOREVER); // waits while the queue is full
+		}
+		thread_sleep(SEC(1));
+	}
+}
+
+void consumer(void *args)
+{
+	UINT32 msg[MSG_WORDS];
+
+	while (1)
+	{
+		if (msgq_recv_timeout(mqid, msg, SEC(1) / 2) == E_TIMEOUT)
+		{
+			uart_printf("RX : nothing for 0.5 sec\n");
+			continue;
+		}
+		uart_printf("RX : #%u sent at tick %u (%u)\n", msg[0], msg[1], msg[2]);
+		thread_sleep(2); // slower than the producer
+	}
+}
+
+void app_init(void)
+{
+	uart_printf("\n=== Blocking message queue ===\n");
+
+	msgq_create_ex(4, MSG_WORDS, &mqid);
+
+	thread_create(producer, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_prod);
+	thread_create(consumer, NULL, 0, PRIORITY_HIGH, FIFO, &tid_cons);
+	thread_activate(tid_prod);
+	thread_activate(tid_cons);
+}
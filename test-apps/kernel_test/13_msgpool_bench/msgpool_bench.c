@@ -0,0 +1,128 @@
+//========================================================================
+// File		: msgpool_bench.c
+// Description : Zero-copy sensor frames. Cost of one frame round trip
+//		 (get a buffer, send, receive, release) through the heap and
+//		 through a msgpool, then an alarm (ISR) handing frames to a
+//		 thread for a few seconds.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+#define BENCH_LOOPS	100000
+#define BENCH_TIMER	PING6_TIMER	// borrowed channel
+#define FRAME_BYTES	64
+#define POOL_FRAMES	8
+
+UINT32 tid_bench, tid_cons;
+UINT32 mqid, poolid, alid;
+UINT32 n_sent, n_recv, n_drop;
+
+// time per loop, in 0.1us
+static UINT32 bench_dus(UINT32 us)
+{
+	return (UINT32)((uint64_t)us * 10 / BENCH_LOOPS);
+}
+
+static UINT32 bench_heap(void)
+{
+	UINT32 i;
+	UINT8 *frame;
+
+	nos_timer_start(BENCH_TIMER);
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		frame = nos_malloc(FRAME_BYTES);
+		frame[0] = (UINT8)i;
+		msgq_send(mqid, (UINT32 *)&frame);
+		msgq_recv(mqid, (UINT32 *)&frame);
+		nos_free(frame);
+	}
+	return bench_dus(nos_timer_get_time(BENCH_TIMER));
+}
+
+static UINT32 bench_pool(void)
+{
+	UINT32 i;
+	UINT8 *frame;
+
+	nos_timer_start(BENCH_TIMER);
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		frame = msgbuf_alloc(poolid);
+		frame[0] = (UINT8)i;
+		msgq_send_buf(mqid, frame, 0);
+		msgq_recv_buf(mqid, (void **)&frame, 0);
+		msgbuf_free(frame);
+	}
+	return bench_dus(nos_timer_get_time(BENCH_TIMER));
+}
+
+// ISR mode: a sensor frame is ready
+void sensor_isr(UINT32 arg)
+{
+	UINT8 *frame = msgbuf_alloc(poolid);
+
+	if (frame == NULL)
+	{
+		n_drop++;
+		return;
+	}
+
+	memset(frame, (UINT8)n_sent, FRAME_BYTES);
+	if (msgq_send_buf(mqid, frame, 0) != E_OK)
+	{
+		msgbuf_free(frame);
+		n_drop++;
+		return;
+	}
+	n_sent++;
+}
+
+void consumer(void *args)
+{
+	UINT8 *frame;
+
+	while (1)
+	{
+		msgq_recv_buf(mqid, (void **)&frame, WAIT_FOREVER);
+		n_recv += (frame[FRAME_BYTES - 1] == frame[0]);
+		msgbuf_free(frame);
+	}
+}
+
+void bench(void *args)
+{
+	UINT32 t_heap, t_pool;
+
+	uart_printf("Frame round trip, %u bytes (%u loops)\n", FRAME_BYTES, BENCH_LOOPS);
+
+	nos_timer_config(BENCH_TIMER, NOS_TIMER_MAX_US);
+	t_heap = bench_heap();
+	t_pool = bench_pool();
+	nos_timer_release(BENCH_TIMER);
+
+	uart_printf("nos_malloc   + msgq + nos_free    : %3u.%u us\n", t_heap / 10, t_heap % 10);
+	uart_printf("msgbuf_alloc + msgq + msgbuf_free : %3u.%u us\n", t_pool / 10, t_pool % 10);
+
+	thread_create(consumer, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_cons);
+	thread_activate(tid_cons);
+
+	alarm_create(sensor_isr, 0, 1, 1, &alid);
+	alarm_start(alid);
+
+	thread_sleep(SEC(3));
+	alarm_stop(alid);
+
+	uart_printf("ISR -> thread: %u frames sent, %u received intact, %u dropped, min free %u/%u\n",
+		    n_sent, n_recv, n_drop, msgpool_get_min_free(poolid), POOL_FRAMES);
+}
+
+void app_init(void)
+{
+	msgq_create(POOL_FRAMES, &mqid);
+	msgpool_create(FRAME_BYTES, POOL_FRAMES, &poolid);
+
+	thread_create(bench, NULL, 0, PRIORITY_HIGH, FIFO, &tid_bench);
+	thread_activate(tid_bench);
+}
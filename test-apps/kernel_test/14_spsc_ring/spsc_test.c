@@ -0,0 +1,77 @@
+//========================================================================
+// File		: spsc_test.c
+// Description : ISR-to-thread data through the lock-free SPSC ring. An
+//		 alarm (ISR) pushes bursts of a byte sequence like a UART RX
+//		 interrupt; a thread that never masks interrupts drains the
+//		 ring through read regions and checks the sequence.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+#include "spsc_ring.h"
+
+#define RING_SIZE	256
+#define BURST_MAX	97
+
+UINT32 tid_rx, alid_rx;
+SPSC_RING rx_ring;
+UINT8 rx_buf[RING_SIZE];
+
+UINT8 tx_seq;
+UINT32 n_pushed, n_overrun, burst;
+
+// ISR mode
+void rx_isr(UINT32 arg)
+{
+	UINT8 chunk[BURST_MAX];
+	UINT32 i, n;
+
+	burst = (burst * 7 + 13) % BURST_MAX + 1;
+	for (i = 0; i < burst; i++)
+	{
+		chunk[i] = tx_seq + i;
+	}
+
+	n = spsc_ring_push(&rx_ring, chunk, burst);
+	tx_seq += n;
+	n_pushed += n;
+	n_overrun += burst - n;
+}
+
+void rx_task(void *args)
+{
+	UINT8 *p, expect = 0;
+	UINT32 n, i, n_popped = 0, n_bad = 0;
+	UINT64 next = os_tick_get() + SEC(1);
+
+	while (1)
+	{
+		if ((n = spsc_ring_read_region(&rx_ring, &p)) > 0)
+		{
+			for (i = 0; i < n; i++, expect++)
+			{
+				n_bad += (p[i] != expect);
+			}
+			spsc_ring_read_release(&rx_ring, n);
+			n_popped += n;
+		}
+
+		if (os_tick_get() >= next)
+		{
+			next += SEC(1);
+			uart_printf("pushed %6u, popped %6u, bad %u, overrun %u\n",
+				    n_pushed, n_popped, n_bad, n_overrun);
+		}
+	}
+}
+
+void app_init(void)
+{
+	spsc_ring_init(&rx_ring, rx_buf, RING_SIZE);
+
+	thread_create(rx_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_rx);
+	thread_activate(tid_rx);
+
+	alarm_create(rx_isr, 0, 1, 1, &alid_rx);
+	alarm_start(alid_rx);
+}
@@ -0,0 +1,96 @@
+//========================================================================
+// File		: event_group_ex.c
+// Description : Shared event-flag group. One alarm (ISR) sets a flag for
+//		 "sample ready" every 200ms and "button" every 700ms; several
+//		 threads wait on the same group with any/all semantics, one
+//		 consumes the sample flag (auto-clear), one uses a timeout.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+#define EV_SAMPLE	EVENT(0)
+#define EV_BUTTON	EVENT(1)
+
+UINT32 egid, alid;
+UINT32 tid_any, tid_all, tid_sample, tid_timeout;
+UINT32 ticks;
+
+// ISR mode
+void sensor_isr(UINT32 arg)
+{
+	ticks++;
+	if (ticks % 2 == 0)
+	{
+		event_group_set(egid, EV_SAMPLE);	// broadcast to every waiter
+	}
+	if (ticks % 7 == 0)
+	{
+		event_group_set(egid, EV_BUTTON);
+	}
+}
+
+void any_task(void *args)
+{
+	UINT32 flags;
+
+	while (1)
+	{
+		event_group_wait(egid, EV_SAMPLE | EV_BUTTON, EG_WAIT_ANY, &flags, WAIT_FOREVER);
+		uart_printf("[%3u] any    : flags 0x%x\n", ticks, flags);
+		thread_sleep(SEC(1) / 10);	// the flags stay set until someone clears them
+	}
+}
+
+void all_task(void *args)
+{
+	UINT32 flags;
+
+	while (1)
+	{
+		event_group_wait(egid, EV_SAMPLE | EV_BUTTON, EG_WAIT_ALL, &flags, WAIT_FOREVER);
+		uart_printf("[%3u] all    : flags 0x%x, clearing the button\n", ticks, flags);
+		event_group_clear(egid, EV_BUTTON);
+	}
+}
+
+void sample_task(void *args)
+{
+	while (1)
+	{
+		event_group_wait(egid, EV_SAMPLE, EG_WAIT_ANY | EG_AUTO_CLEAR, NULL, WAIT_FOREVER);
+		uart_printf("[%3u] sample : consumed\n", ticks);
+	}
+}
+
+void timeout_task(void *args)
+{
+	while (1)
+	{
+		if (event_group_wait(egid, EV_BUTTON, EG_WAIT_ANY, NULL, 30) == E_TIMEOUT)
+		{
+			uart_printf("[%3u] timeout: no button for 300 ms\n", ticks);
+		}
+		else
+		{
+			thread_sleep(1);
+		}
+	}
+}
+
+void app_init(void)
+{
+	event_group_create(&egid, 0);
+
+	thread_create(any_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_any);
+	thread_create(all_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_all);
+	thread_create(sample_task, NULL, 0, PRIORITY_LOW, FIFO, &tid_sample);
+	thread_create(timeout_task, NULL, 0, PRIORITY_HIGH, FIFO, &tid_timeout);
+	thread_activate(tid_any);
+	thread_activate(tid_all);
+	thread_activate(tid_sample);
+	thread_activate(tid_timeout);
+
+	alarm_create(sensor_isr, 0, SEC(1) / 10, SEC(1) / 10, &alid);
+	alarm_start(alid);
+}
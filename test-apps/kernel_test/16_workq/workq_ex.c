@@ -0,0 +1,121 @@
+//========================================================================
+// File		: workq_ex.c
+// Description : Deferred work queues. An alarm (ISR) defers an urgent
+//		 item to a high priority queue and a slow item to a low
+//		 priority queue every 100ms; a burst of 20 items shows the
+//		 batched draining. Resubmitting a pending item is a no-op,
+//		 also from the handler of an earlier item of the same batch.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+#define BURST	20
+
+UINT32 wq_urgent, wq_background, wq_check;
+UINT32 alid, tid_main;
+UINT32 ticks;
+UINT32 n_urgent, n_slow, n_burst, n_submit_slow;
+UINT32 urgent_lat_max;
+UINT64 t_submit;
+
+WORK urgent_work, slow_work;
+WORK burst_work[BURST];
+WORK work_a, work_b, work_c;
+UINT32 n_a, n_b, n_c;
+
+void urgent(void *args)
+{
+	UINT32 lat = (UINT32)(os_time_get_us() - t_submit);
+
+	n_urgent++;
+	if (lat > urgent_lat_max)
+	{
+		urgent_lat_max = lat;
+	}
+}
+
+void slow(void *args)
+{
+	n_slow++;
+	nos_delay_ms(150);
+}
+
+void burst(void *args)
+{
+	n_burst++;
+}
+
+void count(void *args)
+{
+	(*(UINT32 *)args)++;
+}
+
+// a, b and c are in one batch: b is still pending here
+void resubmit_b(void *args)
+{
+	n_a++;
+	work_submit(wq_check, &work_b);
+}
+
+// ISR mode
+void tick_isr(UINT32 arg)
+{
+	ticks++;
+	t_submit = os_time_get_us();
+	work_submit(wq_urgent, &urgent_work);
+
+	n_submit_slow++;
+	work_submit(wq_background, &slow_work);	// ignored while still pending
+}
+
+void main_task(void *args)
+{
+	UINT32 i, round = 0;
+
+	work_submit(wq_check, &work_a);
+	work_submit(wq_check, &work_b);
+	work_submit(wq_check, &work_c);
+	thread_sleep(SEC(1) / 2);
+	uart_printf("resubmit within a batch: a %u b %u c %u (expected 1 1 1)\n", n_a, n_b, n_c);
+
+	while (1)
+	{
+		thread_sleep(SEC(1));
+
+		for (i = 0; i < BURST; i++)
+		{
+			work_submit(wq_background, &burst_work[i]);
+		}
+
+		uart_printf("[%u] urgent %u (max latency %u us), slow %u of %u submits, burst %u\n",
+			    ++round, n_urgent, urgent_lat_max, n_slow, n_submit_slow, n_burst);
+	}
+}
+
+void app_init(void)
+{
+	UINT32 i;
+
+	uart_printf("\n\r*** Deferred work queues ***\n\r");
+
+	workq_create(&wq_urgent, PRIORITY_HIGHEST, 0, 0);
+	workq_create(&wq_background, PRIORITY_LOW, 0, 4);
+	workq_create(&wq_check, PRIORITY_LOW, 0, 0);
+
+	work_init(&urgent_work, urgent, NULL);
+	work_init(&slow_work, slow, NULL);
+	for (i = 0; i < BURST; i++)
+	{
+		work_init(&burst_work[i], burst, NULL);
+	}
+	work_init(&work_a, resubmit_b, NULL);
+	work_init(&work_b, count, &n_b);
+	work_init(&work_c, count, &n_c);
+
+	thread_create(main_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_main);
+	thread_activate(tid_main);
+
+	alarm_create(tick_isr, 0, SEC(1) / 10, SEC(1) / 10, &alid);
+	alarm_start(alid);
+}
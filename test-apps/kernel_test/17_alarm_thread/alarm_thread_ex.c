@@ -0,0 +1,72 @@
+//========================================================================
+// File		: alarm_thread_ex.c
+// Description : Alarm handlers in the timer thread (ALARM_THREAD). A slow
+//		 alarm handler (5ms of work) no longer stretches the tick
+//		 interrupt: the tick ISR time and the wakeup lateness of a
+//		 high priority thread stay small. Build without ALARM_THREAD
+//		 to compare.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+UINT32 alid_slow, alid_fast;
+UINT32 tid_rt, tid_report;
+UINT32 n_slow, n_fast;
+UINT32 late_max_us;
+
+void slow_alarm(UINT32 arg)
+{
+	n_slow++;
+	nos_delay_ms(5);
+}
+
+void fast_alarm(UINT32 arg)
+{
+	n_fast++;
+}
+
+// above the timer thread; wakes up every 2 ticks, measures how late it runs
+void rt_task(void *args)
+{
+	UINT64 expected;
+	UINT32 late;
+
+	while (1)
+	{
+		expected = (os_time_get_us() / 10000 + 2) * 10000;
+		thread_sleep(2);
+		late = (UINT32)(os_time_get_us() - expected);
+		if ((INT32)late > 0 && late > late_max_us)
+		{
+			late_max_us = late;
+		}
+	}
+}
+
+void report_task(void *args)
+{
+	while (1)
+	{
+		thread_sleep(SEC(1));
+		uart_printf("slow %u, fast %u, tick ISR max %u us (%u ticks), wakeup late max %u us\n",
+			    n_slow, n_fast, get_tick_isr_max_us(), get_tick_isr_count(), late_max_us);
+		reset_tick_isr_stats();
+		late_max_us = 0;
+	}
+}
+
+void app_init(void)
+{
+	uart_printf("\n\r*** Alarm handlers in the timer thread ***\n\r");
+
+	thread_create(rt_task, NULL, 0, PRIORITY(7), FIFO, &tid_rt);
+	thread_create(report_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_report);
+	thread_activate(tid_rt);
+	thread_activate(tid_report);
+
+	alarm_create(slow_alarm, 0, SEC(1) / 10, SEC(1) / 10, &alid_slow);
+	alarm_create(fast_alarm, 0, 1, 1, &alid_fast);
+	alarm_start(alid_slow);
+	alarm_start(alid_fast);
+}
@@ -0,0 +1,97 @@
+//========================================================================
+// File		: hrtimer_ex.c
+// Description : High-resolution timers. A 500us periodic timer reports
+//		 its lateness; a burst of 64 one-shot timers at random
+//		 microsecond deadlines checks that they expire in deadline
+//		 order and never early.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+#define PERIOD_US	500
+#define N_SHOT		64
+
+HRTIMER periodic;
+HRTIMER shot[N_SHOT];
+
+UINT32 tid_main;
+UINT32 n_periodic, late_max, late_sum;
+UINT32 n_shot, n_early, n_order;
+UINT32 last_expires;
+UINT32 seed = 12345;
+
+// ISR mode
+void periodic_cb(void *args)
+{
+	UINT32 late = hrtimer_now() - hrtimer_expires(&periodic);
+
+	n_periodic++;
+	late_sum += late;
+	if (late > late_max)
+	{
+		late_max = late;
+	}
+	hrtimer_forward(&periodic, PERIOD_US);
+}
+
+// ISR mode
+void shot_cb(void *args)
+{
+	HRTIMER *t = (HRTIMER *)args;
+
+	n_shot++;
+	if (HRTIME_BEFORE(hrtimer_now(), hrtimer_expires(t)))
+	{
+		n_early++;
+	}
+	if (HRTIME_BEFORE(hrtimer_expires(t), last_expires))
+	{
+		n_order++;
+	}
+	last_expires = hrtimer_expires(t);
+}
+
+void main_task(void *args)
+{
+	UINT32 i, now, round = 0;
+
+	while (1)
+	{
+		/* random deadlines within the next 20ms */
+		os_sched_lock();
+		now = hrtimer_now();
+		last_expires = now;
+		for (i = 0; i < N_SHOT; i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			hrtimer_start_at(&shot[i], now + 100 + (seed >> 8) % 20000);
+		}
+		os_sched_unlock();
+
+		thread_sleep(SEC(1));
+
+		uart_printf("[%u] periodic %u, late avg %u us max %u us; shots %u, early %u, out of order %u\n",
+			    ++round, n_periodic, late_sum / (n_periodic ? n_periodic : 1), late_max,
+			    n_shot, n_early, n_order);
+		n_periodic = late_sum = late_max = 0;
+	}
+}
+
+void app_init(void)
+{
+	UINT32 i;
+
+	uart_printf("\n\r*** High-resolution timers ***\n\r");
+
+	hrtimer_init(&periodic, periodic_cb, NULL);
+	for (i = 0; i < N_SHOT; i++)
+	{
+		hrtimer_init(&shot[i], shot_cb, &shot[i]);
+	}
+
+	thread_create(main_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_main);
+	thread_activate(tid_main);
+
+	hrtimer_start(&periodic, PERIOD_US);
+}
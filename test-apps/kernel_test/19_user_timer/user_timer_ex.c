@@ -0,0 +1,94 @@
+//========================================================================
+// File		: user_timer_ex.c
+// Description : User timers on tick_q. 40 periodic timers with caller
+//		 storage (more than the ID table holds), an ID timer that
+//		 is rescheduled, stopped and destroyed, and a Trickle timer
+//		 (lib/trickle.c) built on the ID functions.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+#include "trickle.h"
+
+#define N_STATIC	40
+
+NOS_USER_TIMER static_timer[N_STATIC];
+UINT32 static_runs[N_STATIC];
+UINT32 id_runs, trickle_runs;
+INT8 tid;
+TRICKLE trickle;
+UINT32 tid_main;
+
+// ISR mode
+void static_cb(void *args)
+{
+	static_runs[(UINT32)args]++;
+}
+
+void id_cb(void *args)
+{
+	id_runs++;
+}
+
+void trickle_cb(void *args)
+{
+	trickle_runs++;
+}
+
+void main_task(void *args)
+{
+	UINT32 i, sum, round = 0;
+
+	while (1)
+	{
+		thread_sleep(SEC(1));
+		round++;
+
+		for (i = 0, sum = 0; i < N_STATIC; i++)
+		{
+			sum += static_runs[i];
+		}
+		uart_printf("[%u] static timers %u runs (10ms: %u, 400ms: %u), id timer %u, trickle %u\n",
+			    round, sum, static_runs[0], static_runs[N_STATIC - 1], id_runs, trickle_runs);
+
+		switch (round)
+		{
+		case 1:
+			nos_user_timer_reschedule(tid, MSEC(50));	// 10 -> 20 runs/s
+			break;
+		case 2:
+			nos_user_timer_deactivate(tid);
+			break;
+		case 3:
+			nos_user_timer_activate(tid);
+			break;
+		case 4:
+			nos_user_timer_destroy_by_arg(id_cb, NULL);
+			for (i = 0; i < N_STATIC; i += 2)
+			{
+				nos_user_timer_stop(&static_timer[i]);
+			}
+			break;
+		}
+	}
+}
+
+void app_init(void)
+{
+	UINT32 i;
+
+	uart_printf("\n\r*** User timers ***\n\r");
+
+	for (i = 0; i < N_STATIC; i++)
+	{
+		nos_user_timer_setup(&static_timer[i], static_cb, (void *)i, i + 1, TRUE);
+		nos_user_timer_start(&static_timer[i]);
+	}
+
+	tid = nos_user_timer_create_ms(id_cb, NULL, 100, NOS_USER_TIMER_PERIODIC);
+
+	trickle_create(&trickle, 7, 3, 1, trickle_cb, NULL);	// 128ms .. 1s
+
+	thread_create(main_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_main);
+	thread_activate(tid_main);
+}
@@ -0,0 +1,61 @@
+//========================================================================
+// File		: rr_slice.c
+// Description : Round-robin time slicing. Three CPU-bound RR threads of the
+//		 same priority share the CPU in proportion to their quanta;
+//		 a high priority thread reports their progress every second.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+UINT32 tid[3], tid_report;
+UINT32 quantum[3] = { 2, 5, 10 };
+volatile UINT32 loops[3];
+
+void spin(void *args)
+{
+	UINT32 id = (UINT32)args;
+
+	while (1)
+	{
+		loops[id]++;	// never blocks nor yields
+	}
+}
+
+void report(void *args)
+{
+	UINT32 i, total;
+
+	while (1)
+	{
+		thread_sleep(SEC(1));
+
+		total = loops[0] + loops[1] + loops[2];
+		if (total == 0)
+		{
+			total = 1;
+		}
+		for (i = 0; i < 3; i++)
+		{
+			uart_printf("T%u (quantum %2u): %3u%% of loops, %u preempted, %u switched\n",
+				    i, quantum[i], loops[i] / (total / 100 + 1),
+				    get_thread_preempt_count(tid[i]), get_thread_switch_count(tid[i]));
+		}
+		uart_printf("\n");
+	}
+}
+
+void app_init(void)
+{
+	UINT32 i;
+
+	for (i = 0; i < 3; i++)
+	{
+		thread_create(spin, (void *)i, 0, PRIORITY_NORMAL, RR, &tid[i]);
+		thread_set_quantum(tid[i], quantum[i]);
+		thread_activate(tid[i]);
+	}
+
+	thread_create(report, NULL, 0, PRIORITY_HIGH, FIFO, &tid_report);
+	thread_activate(tid_report);
+}
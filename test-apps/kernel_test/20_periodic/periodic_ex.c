@@ -0,0 +1,79 @@
+//========================================================================
+// File		: periodic_ex.c
+// Description : Periodic threads. A 100ms sampling job with a 50ms
+//		 deadline runs 20ms of work, 70ms every 7th job (deadline
+//		 miss) and 130ms every 10th job (overrun). A loop written as
+//		 work + thread_sleep(period) runs next to it and drifts.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+#define PERIOD		MSEC(100)
+#define DEADLINE	MSEC(50)
+
+UINT32 tid_periodic, tid_sleep, tid_report;
+UINT32 jobs_periodic, jobs_sleep;
+
+void periodic_task(void *args)
+{
+	UINT32 n = 0;
+
+	while (1)
+	{
+		n++;
+		if (n % 10 == 0)
+		{
+			nos_delay_ms(130);
+		}
+		else if (n % 7 == 0)
+		{
+			nos_delay_ms(70);
+		}
+		else
+		{
+			nos_delay_ms(20);
+		}
+		jobs_periodic++;
+
+		thread_wait_next_period();
+	}
+}
+
+void sleep_task(void *args)
+{
+	while (1)
+	{
+		nos_delay_ms(20);
+		jobs_sleep++;
+
+		thread_sleep(PERIOD);
+	}
+}
+
+void report_task(void *args)
+{
+	UINT32 sec = 0;
+
+	while (1)
+	{
+		thread_sleep(SEC(1));
+		sec++;
+		uart_printf("%2us: periodic %u jobs (overruns %u, deadline misses %u, worst response %u us), sleep loop %u jobs\n",
+			    sec, jobs_periodic, get_thread_overrun_count(tid_periodic),
+			    get_thread_deadline_miss_count(tid_periodic),
+			    get_thread_max_response_us(tid_periodic), jobs_sleep);
+	}
+}
+
+void app_init(void)
+{
+	uart_printf("\n\r*** Periodic threads ***\n\r");
+
+	thread_create_periodic(periodic_task, NULL, 0, PRIORITY_HIGH, PERIOD, DEADLINE, &tid_periodic);
+	thread_create(sleep_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_sleep);
+	thread_create(report_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_report);
+	thread_activate(tid_periodic);
+	thread_activate(tid_sleep);
+	thread_activate(tid_report);
+}
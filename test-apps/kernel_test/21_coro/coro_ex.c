@@ -0,0 +1,252 @@
+//========================================================================
+// File		: coro_ex.c
+// Description : Stackless coroutines. First the cost of a switch between
+//		 two coroutines is compared with a switch between two
+//		 threads (thread_yield), and the RAM of a coroutine with the
+//		 TCB and stack of a thread. A coroutine wakes a sibling of
+//		 the same batch of the executor. Then 200 sensor coroutines with
+//		 their own periods, a message queue consumer, an event group
+//		 waiter and a coroutine woken by an alarm share one executor.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+#define ROUNDS		100000	// switches per pair
+#define N_SENSOR	200
+
+typedef struct
+{
+	CORO	co;
+	UINT32	period;		// ticks
+	UINT32	runs;
+} SENSOR;
+
+UINT32 exec_bench, exec_main;
+UINT32 tid_main, tid_feeder, tid_ping, tid_pong;
+UINT32 mqid, egid, alid;
+
+UINT64 t_end;
+UINT32 n_yield;
+
+CORO co_ping, co_pong, co_consumer, co_waiter, co_alarm;
+CORO co_a, co_b, co_c;
+SENSOR sensor[N_SENSOR];
+
+UINT32 n_a, n_b, n_c;
+UINT32 msg, n_msg, n_msg_timeout, n_group, n_alarm;
+
+/* switch cost */
+
+void yield_task(void *args)
+{
+	UINT32 i;
+
+	for (i = 0; i < ROUNDS; i++)
+	{
+		thread_yield();
+	}
+	t_end = os_time_get_us();
+}
+
+int yield_coro(CORO *co)
+{
+	CORO_BEGIN(co);
+	for (n_yield = 0; n_yield < 2 * ROUNDS; n_yield++)	// the two share n_yield
+	{
+		CORO_YIELD(co);
+	}
+	t_end = os_time_get_us();
+	CORO_END(co);
+}
+
+/* a wakes b, which is still queued behind it with c */
+
+int wake_b_coro(CORO *co)
+{
+	CORO_BEGIN(co);
+	n_a++;
+	coro_event_set(&co_b, 0x1);
+	CORO_END(co);
+}
+
+int woken_coro(CORO *co)
+{
+	static UINT32 got;
+
+	CORO_BEGIN(co);
+	CORO_EVENT_WAIT(co, 0x1, got);
+	n_b++;
+	CORO_END(co);
+}
+
+int count_coro(CORO *co)
+{
+	CORO_BEGIN(co);
+	(*(UINT32 *)co->args)++;
+	CORO_END(co);
+}
+
+/* the shared executor */
+
+int sensor_coro(CORO *co)
+{
+	SENSOR *s = (SENSOR *)co->args;
+
+	CORO_BEGIN(co);
+	while (1)
+	{
+		CORO_SLEEP(co, s->period);
+		s->runs++;
+	}
+	CORO_END(co);
+}
+
+int consumer_coro(CORO *co)
+{
+	static STATUS status;
+
+	CORO_BEGIN(co);
+	while (1)
+	{
+		CORO_MSGQ_RECV(co, mqid, &msg, SEC(1) * 3 / 20, status);
+		if (status == E_OK)
+		{
+			n_msg++;
+		}
+		else
+		{
+			n_msg_timeout++;
+		}
+	}
+	CORO_END(co);
+}
+
+int waiter_coro(CORO *co)
+{
+	static STATUS status;
+	static UINT32 flags;
+
+	CORO_BEGIN(co);
+	while (1)
+	{
+		CORO_EVENT_GROUP_WAIT(co, egid, 0x3, EG_WAIT_ALL | EG_AUTO_CLEAR, &flags, WAIT_FOREVER, status);
+		n_group++;
+	}
+	CORO_END(co);
+}
+
+int alarm_coro(CORO *co)
+{
+	static UINT32 got;
+
+	CORO_BEGIN(co);
+	while (1)
+	{
+		CORO_EVENT_WAIT(co, 0x1, got);
+		n_alarm++;
+	}
+	CORO_END(co);
+}
+
+// ISR mode
+void alarm_handler(UINT32 arg)
+{
+	coro_event_set(&co_alarm, 0x1);
+	event_group_set(egid, 0x1);
+}
+
+void feeder_task(void *args)
+{
+	UINT32 n = 0;
+
+	while (1)
+	{
+		thread_sleep(SEC(1) / 5);
+		msgq_send(mqid, &n);
+		n++;
+		event_group_set(egid, 0x2);
+	}
+}
+
+void main_task(void *args)
+{
+	UINT64 t0;
+	UINT32 i, sum, sec = 0;
+
+	uart_printf("RAM: coroutine %u bytes, thread %u bytes TCB + %u bytes stack\n",
+		    sizeof(CORO), sizeof(THREAD), DEFAULT_STACK_SIZE);
+
+	/* both of a pair are ready before they start, above this thread */
+	thread_create(yield_task, NULL, 0, PRIORITY_HIGH, FIFO, &tid_ping);
+	thread_create(yield_task, NULL, 0, PRIORITY_HIGH, FIFO, &tid_pong);
+	thread_priority_change(SELF, PRIORITY_HIGHEST);
+	thread_activate(tid_ping);
+	thread_activate(tid_pong);
+	t0 = os_time_get_us();
+	thread_priority_change(SELF, PRIORITY_LOW);	// returns when they are done
+	uart_printf("thread switch    : %u ns\n", (UINT32)((t_end - t0) * 1000 / (2 * ROUNDS)));
+
+	coro_init(&co_ping, yield_coro, NULL);
+	coro_init(&co_pong, yield_coro, NULL);
+	thread_priority_change(SELF, PRIORITY_HIGHEST);
+	coro_start(exec_bench, &co_ping);
+	coro_start(exec_bench, &co_pong);
+	t0 = os_time_get_us();
+	thread_priority_change(SELF, PRIORITY_LOW);
+	uart_printf("coroutine switch : %u ns\n", (UINT32)((t_end - t0) * 1000 / (2 * ROUNDS)));
+
+	coro_init(&co_a, wake_b_coro, NULL);
+	coro_init(&co_b, woken_coro, NULL);
+	coro_init(&co_c, count_coro, &n_c);
+	thread_priority_change(SELF, PRIORITY_HIGHEST);
+	coro_start(exec_bench, &co_a);
+	coro_start(exec_bench, &co_b);
+	coro_start(exec_bench, &co_c);
+	thread_priority_change(SELF, PRIORITY_LOW);
+	uart_printf("wake within a batch: a %u b %u c %u, done %u%u%u (expected 1 1 1, 111)\n",
+		    n_a, n_b, n_c, coro_is_done(&co_a), coro_is_done(&co_b), coro_is_done(&co_c));
+
+	for (i = 0; i < N_SENSOR; i++)
+	{
+		sensor[i].period = 5 + i % 20;
+		coro_init(&sensor[i].co, sensor_coro, &sensor[i]);
+		coro_start(exec_main, &sensor[i].co);
+	}
+	coro_init(&co_consumer, consumer_coro, NULL);
+	coro_init(&co_waiter, waiter_coro, NULL);
+	coro_init(&co_alarm, alarm_coro, NULL);
+	coro_start(exec_main, &co_consumer);
+	coro_start(exec_main, &co_waiter);
+	coro_start(exec_main, &co_alarm);
+
+	thread_activate(tid_feeder);
+	alarm_start(alid);
+
+	while (1)
+	{
+		thread_sleep(SEC(1));
+		for (i = 0, sum = 0; i < N_SENSOR; i++)
+		{
+			sum += sensor[i].runs;
+		}
+		uart_printf("[%u] %u coroutines: sensor runs %u, msgs %u (timeouts %u), group %u, alarm %u\n",
+			    ++sec, N_SENSOR + 3, sum, n_msg, n_msg_timeout, n_group, n_alarm);
+	}
+}
+
+void app_init(void)
+{
+	uart_printf("\n\r*** Stackless coroutines ***\n\r");
+
+	workq_create(&exec_bench, PRIORITY_HIGH, 0, 0);
+	workq_create(&exec_main, PRIORITY_NORMAL, 0, 0);
+
+	msgq_create(4, &mqid);
+	event_group_create(&egid, 0);
+	alarm_create(alarm_handler, 0, SEC(1) / 2, SEC(1) / 2, &alid);
+
+	thread_create(feeder_task, NULL, 0, PRIORITY_HIGH, FIFO, &tid_feeder);
+	thread_create(main_task, NULL, 0, PRIORITY_LOW, FIFO, &tid_main);
+	thread_activate(tid_main);
+}
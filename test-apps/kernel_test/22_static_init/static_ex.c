@@ -0,0 +1,219 @@
+//========================================================================
+// File		: static_ex.c
+// Description : Static allocation of kernel objects. The same set of
+//		 objects is built N times with the *_create() constructors
+//		 (heap) and with the *_init() variants (storage given by the
+//		 application), and the time and the heap bytes of both are
+//		 compared, with the heap in use when app_init() starts. Then a
+//		 producer and a consumer thread, both static, run over a
+//		 static message queue, message pool and semaphore.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+#define N_ROUND		1000
+#define Q_LEN		8
+#define BUF_SIZE	32
+#define N_BUF		4
+
+/* static storage of every object */
+SEM sem;
+MUTEX mutex;
+EVENT_GROUP group;
+MSGQ msgq;
+MSGQ_BUFFER_DEFINE(msgq_buf, Q_LEN, 1);
+MSGPOOL pool;
+MSGPOOL_MEM_DEFINE(pool_mem, BUF_SIZE, N_BUF);
+ALARM alarm0;
+
+THREAD tcb_producer, tcb_consumer;
+THREAD_STACK_DEFINE(stack_producer, 1024);
+THREAD_STACK_DEFINE(stack_consumer, 1024);
+
+UINT32 semid, muid, egid, mqid, poolid, alid;
+UINT32 tid_producer, tid_consumer, tid_main;
+UINT32 n_sent, n_recv, n_tick;
+UINT32 boot_us, boot_heap, thread_heap;
+
+void alarm_handler(UINT32 arg)
+{
+	n_tick++;
+	sem_post(semid);
+}
+
+void producer_task(void *args)
+{
+	UINT32 *buf;
+
+	while (1)
+	{
+		sem_wait(semid);
+		if ((buf = msgbuf_alloc(poolid)) != NULL)
+		{
+			*buf = n_sent++;
+			msgq_send_buf(mqid, buf, WAIT_FOREVER);
+		}
+	}
+}
+
+void consumer_task(void *args)
+{
+	void *buf;
+
+	while (1)
+	{
+		if (msgq_recv_buf(mqid, &buf, WAIT_FOREVER) == E_OK)
+		{
+			n_recv++;
+			msgbuf_free(buf);
+		}
+	}
+}
+
+UINT32 bench_create(void)
+{
+	UINT64 t0 = os_time_get_us();
+	UINT32 i;
+
+	for (i = 0; i < N_ROUND; i++)
+	{
+		sem_create(&semid, 0, 1);
+		mutex_create(&muid, 0);
+		event_group_create(&egid, 0);
+		msgq_create(Q_LEN, &mqid);
+		msgpool_create(BUF_SIZE, N_BUF, &poolid);
+		alarm_create(alarm_handler, 0, 1, 1, &alid);
+
+		alarm_destroy(alid);
+		msgpool_destroy(poolid);
+		msgq_destroy(mqid);
+		event_group_destroy(egid);
+		mutex_destroy(muid);
+		sem_destroy(semid);
+	}
+
+	return (UINT32)((os_time_get_us() - t0) * 1000 / N_ROUND);
+}
+
+UINT32 bench_init(void)
+{
+	UINT64 t0 = os_time_get_us();
+	UINT32 i;
+
+	for (i = 0; i < N_ROUND; i++)
+	{
+		sem_init(&sem, &semid, 0, 1);
+		mutex_init(&mutex, &muid, 0);
+		event_group_init(&group, &egid, 0);
+		msgq_init(&msgq, msgq_buf, Q_LEN, 1, &mqid);
+		msgpool_init(&pool, pool_mem, BUF_SIZE, N_BUF, &poolid);
+		alarm_init(&alarm0, alarm_handler, 0, 1, 1, &alid);
+
+		alarm_destroy(alid);
+		msgpool_destroy(poolid);
+		msgq_destroy(mqid);
+		event_group_destroy(egid);
+		mutex_destroy(muid);
+		sem_destroy(semid);
+	}
+
+	return (UINT32)((os_time_get_us() - t0) * 1000 / N_ROUND);
+}
+
+static UINT32 heap_used(void)
+{
+	TLSF_STATS s;
+
+	nos_heap_get_stats(&s);
+	return s.used;
+}
+
+// heap bytes, headers included, that the 6 objects hold while they exist
+UINT32 heap_create(void)
+{
+	UINT32 used = heap_used();
+
+	sem_create(&semid, 0, 1);
+	mutex_create(&muid, 0);
+	event_group_create(&egid, 0);
+	msgq_create(Q_LEN, &mqid);
+	msgpool_create(BUF_SIZE, N_BUF, &poolid);
+	alarm_create(alarm_handler, 0, 1, 1, &alid);
+	used = heap_used() - used;
+
+	alarm_destroy(alid);
+	msgpool_destroy(poolid);
+	msgq_destroy(mqid);
+	event_group_destroy(egid);
+	mutex_destroy(muid);
+	sem_destroy(semid);
+	return used;
+}
+
+UINT32 heap_init(void)
+{
+	UINT32 used = heap_used();
+
+	sem_init(&sem, &semid, 0, 1);
+	mutex_init(&mutex, &muid, 0);
+	event_group_init(&group, &egid, 0);
+	msgq_init(&msgq, msgq_buf, Q_LEN, 1, &mqid);
+	msgpool_init(&pool, pool_mem, BUF_SIZE, N_BUF, &poolid);
+	alarm_init(&alarm0, alarm_handler, 0, 1, 1, &alid);
+	used = heap_used() - used;
+
+	alarm_destroy(alid);
+	msgpool_destroy(poolid);
+	msgq_destroy(mqid);
+	event_group_destroy(egid);
+	mutex_destroy(muid);
+	sem_destroy(semid);
+	return used;
+}
+
+void main_task(void *args)
+{
+	UINT32 sec = 0;
+
+	uart_printf("boot: app_init() at %u us, %u heap bytes in use\n", boot_us, boot_heap);
+	uart_printf("build + destroy of 6 objects: create %u ns, init %u ns\n", bench_create(), bench_init());
+	uart_printf("heap taken by 6 objects: create %u bytes, init %u bytes\n", heap_create(), heap_init());
+	uart_printf("heap taken by thread_create() of main_task: %u bytes\n", thread_heap);
+	uart_printf("heap not used: objects %u bytes, 2 threads %u bytes, idle + super threads %u bytes\n",
+		    sizeof(sem) + sizeof(mutex) + sizeof(group) + sizeof(msgq) + sizeof(msgq_buf) +
+		    sizeof(pool) + sizeof(pool_mem) + sizeof(alarm0),
+		    2 * sizeof(THREAD) + sizeof(stack_producer) + sizeof(stack_consumer),
+		    2 * (sizeof(THREAD) + SYSTEM_STACK_SIZE + STACK_GUARD_SIZE));
+
+	/* every object of the run is static */
+	sem_init(&sem, &semid, 0, 1);
+	msgq_init(&msgq, msgq_buf, Q_LEN, 1, &mqid);
+	msgpool_init(&pool, pool_mem, BUF_SIZE, N_BUF, &poolid);
+	alarm_init(&alarm0, alarm_handler, 0, SEC(1) / 10, SEC(1) / 10, &alid);
+
+	thread_init(&tcb_producer, stack_producer, sizeof(stack_producer), producer_task, NULL, PRIORITY_NORMAL, FIFO, &tid_producer);
+	thread_init(&tcb_consumer, stack_consumer, sizeof(stack_consumer), consumer_task, NULL, PRIORITY_NORMAL, FIFO, &tid_consumer);
+	thread_activate(tid_producer);
+	thread_activate(tid_consumer);
+	alarm_start(alid);
+
+	while (1)
+	{
+		thread_sleep(SEC(1));
+		uart_printf("[%u] alarms %u, sent %u, received %u\n", ++sec, n_tick, n_sent, n_recv);
+	}
+}
+
+void app_init(void)
+{
+	uart_printf("\n\r*** Static kernel objects ***\n\r");
+
+	/* the idle and super threads are static: the heap is still empty */
+	boot_us = (UINT32)os_time_get_us();
+	boot_heap = heap_used();
+
+	thread_create(main_task, NULL, 0, PRIORITY_LOW, FIFO, &tid_main);
+	thread_heap = heap_used() - boot_heap;
+	thread_activate(tid_main);
+}
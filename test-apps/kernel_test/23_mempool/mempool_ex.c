@@ -0,0 +1,134 @@
+//========================================================================
+// File		: mempool_ex.c
+// Description : Fixed-block memory pools. The cost of an alloc/free pair
+//		 from a pool and from the heap, a pool growing into its
+//		 backing region, an alarm (ISR) taking blocks that a thread
+//		 returns, and kernel objects taken from their own pools
+//		 (MEMPOOL_KOBJ).
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+#define N_ROUND		100000
+#define BLOCK_SIZE	32
+#define N_OWN		4	// blocks of the growing pool
+#define N_BACKING	12	// blocks of its backing region
+#define N_ALARM		10	// above CONFIG_MEMPOOL_KOBJ_COUNT
+
+MEMPOOL_MEM_DEFINE(own_mem, BLOCK_SIZE, N_OWN);
+MEMPOOL_MEM_DEFINE(backing_mem, BLOCK_SIZE, N_BACKING);
+MEMPOOL grow_pool;
+
+UINT32 mpid_bench, mpid_grow, mpid_isr;
+UINT32 mqid, alid, tid_main, tid_sink;
+UINT32 alid_obj[N_ALARM];
+UINT32 n_isr_alloc, n_isr_fail, n_sink;
+
+// ISR mode
+void sample_handler(UINT32 arg)
+{
+	UINT32 *block = mempool_alloc(mpid_isr);
+
+	if (block == NULL)
+	{
+		n_isr_fail++;
+		return;
+	}
+	*block = n_isr_alloc++;
+	if (msgq_send(mqid, (UINT32 *)&block) != E_OK)
+	{
+		mempool_free(mpid_isr, block);
+	}
+}
+
+void sink_task(void *args)
+{
+	UINT32 *block;
+
+	while (1)
+	{
+		msgq_recv_timeout(mqid, (UINT32 *)&block, WAIT_FOREVER);
+		n_sink++;
+		mempool_free(mpid_isr, block);
+	}
+}
+
+void print_stats(const char *name, UINT32 mpid)
+{
+	MEMPOOL_STATS s;
+
+	mempool_get_stats(mpid, &s);
+	uart_printf("   %-12s block %3u, capacity %3u, used %3u (max %3u), allocs %6u, failed %u, grown %u\n",
+		    name, s.block_size, s.capacity, s.used, s.max_used, s.alloc_count, s.alloc_fail, s.grown);
+}
+
+void main_task(void *args)
+{
+	UINT64 t0;
+	UINT32 i, t_pool, t_heap, sec = 0;
+	void *p;
+
+	/* alloc/free pair cost */
+	mempool_create(BLOCK_SIZE, 16, &mpid_bench);
+	t0 = os_time_get_us();
+	for (i = 0; i < N_ROUND; i++)
+	{
+		p = mempool_alloc(mpid_bench);
+		mempool_free(mpid_bench, p);
+	}
+	t_pool = (UINT32)((os_time_get_us() - t0) * 1000 / N_ROUND);
+	t0 = os_time_get_us();
+	for (i = 0; i < N_ROUND; i++)
+	{
+		p = nos_malloc(BLOCK_SIZE);
+		nos_free(p);
+	}
+	t_heap = (UINT32)((os_time_get_us() - t0) * 1000 / N_ROUND);
+	uart_printf("alloc + free of %u bytes: pool %u ns, heap %u ns\n", BLOCK_SIZE, t_pool, t_heap);
+
+	/* a static pool growing into its backing region */
+	mempool_init(&grow_pool, own_mem, BLOCK_SIZE, N_OWN, &mpid_grow);
+	mempool_set_backing(mpid_grow, backing_mem, sizeof(backing_mem));
+	for (i = 0; mempool_alloc(mpid_grow) != NULL; i++);
+	uart_printf("growing pool: %u blocks until empty\n", i);
+	print_stats("grow", mpid_grow);
+
+	/* kernel objects: more alarms than their pool holds */
+	for (i = 0; i < N_ALARM; i++)
+	{
+		alarm_create(sample_handler, 0, 1, 1, &alid_obj[i]);
+	}
+	uart_printf("kernel object pools (%u objects each):\n", CONFIG_MEMPOOL_KOBJ_COUNT);
+	print_stats("alarm", mempool_kobj_id(KOBJ_ALARM));
+	for (i = 0; i < N_ALARM; i++)
+	{
+		alarm_destroy(alid_obj[i]);
+	}
+	print_stats("alarm", mempool_kobj_id(KOBJ_ALARM));
+	print_stats("thread", mempool_kobj_id(KOBJ_THREAD));
+	print_stats("msgq", mempool_kobj_id(KOBJ_MSGQ));
+
+	/* blocks taken in ISR mode, returned by a thread */
+	mempool_create(sizeof(UINT32), 4, &mpid_isr);
+	alarm_create(sample_handler, 0, SEC(1) / 20, SEC(1) / 20, &alid);
+	thread_activate(tid_sink);
+	alarm_start(alid);
+
+	while (1)
+	{
+		thread_sleep(SEC(1));
+		uart_printf("[%u] ISR allocs %u (failed %u), returned %u\n", ++sec, n_isr_alloc, n_isr_fail, n_sink);
+		print_stats("isr", mpid_isr);
+	}
+}
+
+void app_init(void)
+{
+	uart_printf("\n\r*** Fixed-block memory pools ***\n\r");
+
+	msgq_create(4, &mqid);
+	thread_create(sink_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_sink);
+	thread_create(main_task, NULL, 0, PRIORITY_LOW, FIFO, &tid_main);
+	thread_activate(tid_main);
+}
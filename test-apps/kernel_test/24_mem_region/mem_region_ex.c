@@ -0,0 +1,194 @@
+//========================================================================
+// File		: mem_region_ex.c
+// Description : Heap regions (HEAP_REGIONS). The context switch time of
+//		 two threads whose TCBs and stacks are in SRAM, CCM or backup
+//		 SRAM, and the time of a Q15 FIR filter loop over data in each
+//		 of them. On the MCU CCM has no wait state and no DMA traffic,
+//		 and the backup SRAM sits on the slower AHB1 bus; on the host
+//		 all three are ordinary memory and only the API is shown.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+#define N_SWITCH	20000	// yields per thread
+#define N_TAP		32
+#define N_SAMPLE	256
+#define N_FIR_ROUND	200
+#define STACK_BYTES	(THREAD_STACK_WORDS(DEFAULT_STACK_SIZE) * sizeof(STACK_ENTRY))
+
+static const char *region_name[MEM_REGIONS] = { "SRAM", "CCM", "BKPSRAM" };
+
+UINT32 tid_main, tid_dummy;
+volatile UINT32 n_done;
+UINT64 t_end;
+
+void yield_task(void *args)
+{
+	UINT32 i;
+
+	for (i = 0; i < N_SWITCH; i++)
+	{
+		thread_yield();
+	}
+	if (++n_done == 2)
+	{
+		t_end = os_time_get_us();
+	}
+}
+
+void dummy_task(void *args)
+{
+}
+
+// ns per switch between two threads in the region, 0 if it has no room
+static UINT32 bench_switch(UINT32 region)
+{
+	THREAD *tcb[2] = { NULL, NULL };
+	STACK_PTR stack[2] = { NULL, NULL };
+	UINT32 i, tid, ns = 0;
+	UINT64 t0;
+
+	for (i = 0; i < 2; i++)
+	{
+		tcb[i] = nos_malloc_region(region, sizeof(THREAD));
+		stack[i] = nos_malloc_region(region, STACK_BYTES);
+		if ((tcb[i] == NULL) || (stack[i] == NULL))
+		{
+			goto out;
+		}
+	}
+
+	/* both run below main_task, from its sleep on */
+	n_done = 0;
+	for (i = 0; i < 2; i++)
+	{
+		thread_init(tcb[i], stack[i], STACK_BYTES, yield_task, NULL, PRIORITY_NORMAL, FIFO, &tid);
+		thread_activate(tid);
+	}
+	t0 = os_time_get_us();
+	while (n_done < 2)
+	{
+		thread_sleep(1);
+	}
+	ns = (UINT32)((t_end - t0) * 1000 / (2 * N_SWITCH));
+
+out:
+	/* the threads have terminated: nothing refers to them any more */
+	for (i = 0; i < 2; i++)
+	{
+		nos_free(tcb[i]);
+		nos_free(stack[i]);
+	}
+	return ns;
+}
+
+// ns per output sample of the filter on data in the region, 0 if it has no room
+static UINT32 bench_fir(UINT32 region, INT32 *check)
+{
+	INT16 *h, *x;
+	INT32 *y, acc;
+	UINT32 i, n, k, ns = 0;
+	UINT64 t0;
+
+	h = nos_malloc_region(region, N_TAP * sizeof(INT16));
+	x = nos_malloc_region(region, (N_SAMPLE + N_TAP) * sizeof(INT16));
+	y = nos_malloc_region(region, N_SAMPLE * sizeof(INT32));
+	if ((h != NULL) && (x != NULL) && (y != NULL))
+	{
+		for (k = 0; k < N_TAP; k++)
+		{
+			h[k] = (INT16)(1000 - 60 * k);
+		}
+		for (n = 0; n < N_SAMPLE + N_TAP; n++)
+		{
+			x[n] = (INT16)((n * 2654435761U) >> 17);
+		}
+
+		t0 = os_time_get_us();
+		for (i = 0; i < N_FIR_ROUND; i++)
+		{
+			for (n = 0; n < N_SAMPLE; n++)
+			{
+				acc = 0;
+				for (k = 0; k < N_TAP; k++)
+				{
+					acc += (INT32)x[n + k] * h[k];
+				}
+				y[n] = acc >> 15;
+			}
+		}
+		ns = (UINT32)((os_time_get_us() - t0) * 1000 / (N_FIR_ROUND * N_SAMPLE));
+
+		for (*check = 0, n = 0; n < N_SAMPLE; n++)
+		{
+			*check += y[n];
+		}
+	}
+	nos_free(h);
+	nos_free(x);
+	nos_free(y);
+	return ns;
+}
+
+static void print_region(UINT32 region)
+{
+	TLSF_STATS s;
+
+	nos_heap_get_region_stats(region, &s);
+	uart_printf("   %-8s heap %7u bytes, used %7u (peak %7u), largest free %7u\n",
+		    region_name[region], s.total, s.used, s.max_used, s.largest_free);
+}
+
+void main_task(void *args)
+{
+	TLSF_STATS before, after;
+	UINT32 r, ns;
+	INT32 check = 0;
+
+	/* the default placement of thread_create() */
+	nos_heap_get_region_stats(MEM_CCM, &before);
+	thread_create(dummy_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_dummy);
+	nos_heap_get_region_stats(MEM_CCM, &after);
+	uart_printf("thread_create(): %u bytes of TCB and stack taken from CCM\n", after.used - before.used);
+
+	uart_printf("context switch (%u yields per thread):\n", N_SWITCH);
+	for (r = 0; r < MEM_REGIONS; r++)
+	{
+		if ((ns = bench_switch(r)) == 0)
+		{
+			uart_printf("   %-8s no room for two stacks of %u bytes\n", region_name[r], STACK_BYTES);
+		}
+		else
+		{
+			uart_printf("   %-8s %5u ns\n", region_name[r], ns);
+		}
+	}
+
+	uart_printf("FIR filter (%u taps, %u samples, %u rounds):\n", N_TAP, N_SAMPLE, N_FIR_ROUND);
+	for (r = 0; r < MEM_REGIONS; r++)
+	{
+		if ((ns = bench_fir(r, &check)) == 0)
+		{
+			uart_printf("   %-8s no room\n", region_name[r]);
+		}
+		else
+		{
+			uart_printf("   %-8s %5u ns per sample (check %d)\n", region_name[r], ns, check);
+		}
+	}
+
+	uart_printf("heap regions:\n");
+	for (r = 0; r < MEM_REGIONS; r++)
+	{
+		print_region(r);
+	}
+}
+
+void app_init(void)
+{
+	uart_printf("\n\r*** Heap regions ***\n\r");
+
+	thread_create(main_task, NULL, 0, PRIORITY_HIGH, FIFO, &tid_main);
+	thread_activate(tid_main);
+}
@@ -0,0 +1,126 @@
+//========================================================================
+// File		: heap_profile_ex.c
+// Description : Heap profiler (HEAP_PROFILE). A sensor thread keeps one
+//		 sample buffer of every four (a leak), a log thread allocates
+//		 and frees messages of random length and a configuration block
+//		 stays for the whole run. Every 2 seconds a binary report is
+//		 written on STDIO. At start a private TLSF heap shows that the
+//		 block checks (HEAP_TLSF_CHECK) refuse double frees. On linux_sim:
+//		   ./25_heap_profile.elf > capture.bin
+//		   $NOS_HOME/tools/heap_report.py capture.bin 25_heap_profile.elf
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+
+#define SAMPLE_BYTES	96
+#define LOG_MAX		200
+
+UINT32 tid_sensor, tid_log, tid_report;
+UINT32 seed = 2025;
+void *config;
+
+TLSF check_heap;
+UINT64 check_pool[64];
+
+static UINT32 ex_rand(void)
+{
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+static void *alloc_sample(void)
+{
+	return nos_malloc(SAMPLE_BYTES);
+}
+
+static void *alloc_log(UINT32 len)
+{
+	return nos_malloc(len);
+}
+
+void sensor_task(void *args)
+{
+	UINT32 n = 0;
+	void *sample;
+
+	while (1)
+	{
+		sample = alloc_sample();
+		if ((++n % 4) != 0)
+		{
+			nos_free(sample);	/* every fourth sample is never freed */
+		}
+		thread_sleep(SEC(1) / 20);
+	}
+}
+
+void log_task(void *args)
+{
+	void *msg[8] = { NULL };
+	UINT32 k;
+
+	while (1)
+	{
+		k = ex_rand() % 8;
+		nos_free(msg[k]);
+		msg[k] = alloc_log(8 + ex_rand() % LOG_MAX);
+		thread_sleep(SEC(1) / 100);
+	}
+}
+
+void report_task(void *args)
+{
+	HEAP_PROFILE_SUMMARY s;
+
+	while (1)
+	{
+		thread_sleep(SEC(2));
+		heap_profile_get_summary(&s);
+		uart_printf("[%u ms] %u allocs, %u frees, live %u blocks / %u bytes (peak %u / %u)\n",
+			    s.now_ms, s.allocs, s.frees, s.live_count, s.live_bytes, s.peak_count, s.peak_bytes);
+		heap_profile_dump(STDIO);
+		uart_printf("\n");
+	}
+}
+
+// q merges into the free p below it, then both are freed again
+static void check_double_free(void)
+{
+	void *p, *q, *r;
+	BOOL ok[4];
+	TLSF_STATS s;
+	UINT32 one;
+
+	tlsf_add_pool(&check_heap, check_pool, sizeof(check_pool));
+	p = tlsf_malloc(&check_heap, 32);
+	q = tlsf_malloc(&check_heap, 32);
+	r = tlsf_malloc(&check_heap, 32);
+	tlsf_get_stats(&check_heap, &s);
+	one = s.used / 3;		/* the three blocks are alike */
+
+	ok[0] = tlsf_free(&check_heap, p);
+	ok[1] = tlsf_free(&check_heap, q);
+	ok[2] = tlsf_free(&check_heap, q);
+	ok[3] = tlsf_free(&check_heap, p);
+	tlsf_get_stats(&check_heap, &s);
+	uart_printf("free p, q, q, p: %u %u %u %u (expected 1 1 0 0), used %u bytes (expected %u, r)\n",
+		    ok[0], ok[1], ok[2], ok[3], s.used, one);
+	tlsf_free(&check_heap, r);
+}
+
+void app_init(void)
+{
+	uart_printf("\n\r*** Heap profiler ***\n\r");
+
+	check_double_free();
+
+	config = nos_malloc(512);
+
+	thread_create(sensor_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_sensor);
+	thread_create(log_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_log);
+	thread_create(report_task, NULL, 0, PRIORITY_LOW, FIFO, &tid_report);
+	thread_activate(tid_sensor);
+	thread_activate(tid_log);
+	thread_activate(tid_report);
+}
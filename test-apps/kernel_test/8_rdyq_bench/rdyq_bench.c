@@ -0,0 +1,84 @@
+//========================================================================
+// File		: rdyq_bench.c
+// Description : Cost of the ready queue operations (os_qPush, os_qRemove,
+//		 os_calHighestThread) with 1..16 priorities in use.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+#include "thread_table.h"
+
+#define BENCH_LOOPS	1000000
+#define BENCH_TIMER	PING6_TIMER	// borrowed channel
+#define BENCH_READY_MAX	16
+
+UINT32 tid1;
+THREAD dummy[BENCH_READY_MAX];
+
+// time per loop, in 0.1ns
+static UINT32 bench_dns(UINT32 us)
+{
+	return (UINT32)((uint64_t)us * 10000 / BENCH_LOOPS);
+}
+
+static void bench_run(UINT32 nready)
+{
+	UINT32 i, t_push_remove, t_highest;
+
+	// spread the dummy threads over the user priorities
+	for (i = 0; i < nready; i++)
+	{
+		dummy[i].priority = 1 + (i * (PRIORITY_LEVEL_COUNT - 2)) / nready;
+		os_qPush(&dummy[i]);
+	}
+
+	nos_timer_start(BENCH_TIMER);
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		THREAD *t = &dummy[i % nready];
+
+		os_qRemove(t);
+		os_qPush(t);
+	}
+	t_push_remove = nos_timer_get_time(BENCH_TIMER);
+
+	nos_timer_start(BENCH_TIMER);
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		os_calHighestThread();
+	}
+	t_highest = nos_timer_get_time(BENCH_TIMER);
+
+	for (i = 0; i < nready; i++)
+	{
+		os_qRemove(&dummy[i]);
+	}
+
+	t_push_remove = bench_dns(t_push_remove);
+	t_highest = bench_dns(t_highest);
+	uart_printf("%2u ready prios : remove+push %4u.%u ns, calHighest %4u.%u ns\n",
+		    nready, t_push_remove / 10, t_push_remove % 10, t_highest / 10, t_highest % 10);
+}
+
+void task1(void *args)
+{
+	UINT32 n;
+
+	uart_printf("Ready queue benchmark (%u priority levels, %u loops)\n",
+		    PRIORITY_LEVEL_COUNT, BENCH_LOOPS);
+
+	nos_timer_config(BENCH_TIMER, NOS_TIMER_MAX_US);
+	for (n = 1; n <= BENCH_READY_MAX; n *= 4)
+	{
+		NOS_ENTER_CRITICAL_SECTION();
+		bench_run(n);
+		NOS_EXIT_CRITICAL_SECTION();
+	}
+	nos_timer_release(BENCH_TIMER);
+}
+
+void app_init(void)
+{
+	thread_create(task1, NULL, 0, PRIORITY_NORMAL, FIFO, &tid1);
+	thread_activate(tid1);
+}
@@ -0,0 +1,93 @@
+//========================================================================
+// File		: tickq_bench.c
+// Description : Cost of the tick_q operations (tickq_Remove + tickq_Push of
+//		 a random delay) with 10, 100 and 1000 pending timers.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+#include "queue_delta.h"
+#include "tick.h"
+
+#define BENCH_LOOPS	100000
+#define BENCH_TIMER	PING6_TIMER	// borrowed channel
+#define BENCH_PENDING_MAX	1000
+#define BENCH_DELAY_MAX	SEC(600)
+
+UINT32 tid1;
+DNODE dnode[BENCH_PENDING_MAX];
+UINT32 n_expired;
+
+static UINT32 seed = 1;
+
+// LCG (Numerical Recipes), deterministic delays
+static UINT32 bench_delay(void)
+{
+	seed = seed * 1664525 + 1013904223;
+	return SEC(1) + (seed >> 8) % BENCH_DELAY_MAX;
+}
+
+static void bench_handler(UINT32 arg)
+{
+	n_expired++;
+}
+
+// time per loop, in 0.1ns
+static UINT32 bench_dns(UINT32 us)
+{
+	return (UINT32)((uint64_t)us * 10000 / BENCH_LOOPS);
+}
+
+static void bench_run(UINT32 npending)
+{
+	UINT32 i, t_restart;
+
+	for (i = 0; i < npending; i++)
+	{
+		init_dnode(&dnode[i], bench_handler, i);
+		tickq_Push(&dnode[i], bench_delay());
+	}
+
+	nos_timer_start(BENCH_TIMER);
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		DNODE *d = &dnode[i % npending];
+
+		tickq_Remove(d);
+		tickq_Push(d, bench_delay());
+	}
+	t_restart = nos_timer_get_time(BENCH_TIMER);
+
+	for (i = 0; i < npending; i++)
+	{
+		tickq_Remove(&dnode[i]);
+	}
+
+	t_restart = bench_dns(t_restart);
+	uart_printf("%4u pending : remove+push %5u.%u ns\n",
+		    npending, t_restart / 10, t_restart % 10);
+}
+
+void task1(void *args)
+{
+	UINT32 n;
+
+	uart_printf("tick_q benchmark (%u loops)\n", BENCH_LOOPS);
+
+	nos_timer_config(BENCH_TIMER, NOS_TIMER_MAX_US);
+	for (n = 10; n <= BENCH_PENDING_MAX; n *= 10)
+	{
+		NOS_ENTER_CRITICAL_SECTION();
+		bench_run(n);
+		NOS_EXIT_CRITICAL_SECTION();
+	}
+	nos_timer_release(BENCH_TIMER);
+
+	uart_printf("expired during the run: %u\n", n_expired);
+}
+
+void app_init(void)
+{
+	thread_create(task1, NULL, 0, PRIORITY_NORMAL, FIFO, &tid1);
+	thread_activate(tid1);
+}
@@ -31,6 +31,7 @@
 #define SCHED_PERIOD_10 1
 #undef SCHED_PERIOD_32
 #undef SCHED_PERIOD_100
+#define SCHED_TICKLESS 1
 #undef TASKQ_LEN_8
 #undef TASKQ_LEN_16
 #define TASKQ_LEN_32 1
@@ -0,0 +1,66 @@
+//========================================================================
+// File		: day_replay.c
+// Description : Replays one day of alarm/sleep traffic on virtual time
+//		 (linux_sim platform with SIM_VIRTUAL_TIME).
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+#include "vtime.h"
+
+UINT32 tid_sync, tid_report;
+UINT32 alid_sample, alid_batch;
+
+UINT32 n_sample, n_batch, n_sync;
+
+// 1 sec sensor sample, 150us of work in the handler
+void sample(UINT32 x)
+{
+	n_sample++;
+	nos_delay_us(150);
+}
+
+// 1 min batch upload, 2ms of work
+void batch(UINT32 x)
+{
+	n_batch++;
+	nos_delay_ms(2);
+}
+
+// sleeps 30 sec, then 5ms of work
+void sync_task(void *args)
+{
+	while (1)
+	{
+		thread_sleep(SEC(30));
+		n_sync++;
+		nos_delay_ms(5);
+	}
+}
+
+void report_task(void *args)
+{
+	NOS_VTIME_STATS s;
+	UINT32 hour = 0;
+
+	while (1)
+	{
+		thread_sleep(SEC(3600));
+		nos_vtime_get_stats(&s);
+		uart_printf("%02u:00  samples %u, batches %u, syncs %u, wakeups %u, max tick_q %u\n",
+			    ++hour, n_sample, n_batch, n_sync, s.wakeups, s.tickq_depth_max);
+	}
+}
+
+void app_init(void)
+{
+	thread_create(sync_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_sync);
+	thread_create(report_task, NULL, 0, PRIORITY_HIGH, FIFO, &tid_report);
+	thread_activate(tid_sync);
+	thread_activate(tid_report);
+
+	alarm_create(sample, 0, SEC(1), SEC(1), &alid_sample);
+	alarm_create(batch, 0, SEC(60), SEC(60), &alid_batch);
+	alarm_start(alid_sample);
+	alarm_start(alid_batch);
+}
@@ -0,0 +1,90 @@
+//========================================================================
+// File		: wearable_alarms.c
+// Description : Timer coalescing on a wearable alarm mix (linux_sim with
+//		 SIM_VIRTUAL_TIME). The first hour runs every alarm at its
+//		 exact expiry, the second hour with slack windows and
+//		 deferrable housekeeping alarms; the tick wakeups of both
+//		 hours are compared.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+#include "vtime.h"
+
+typedef struct
+{
+	const char *name;
+	UINT32 period;		// ticks
+	UINT32 phase;		// first expiry
+	UINT32 slack;		// second hour
+	UINT32 alid;
+	UINT32 runs;
+} WEARABLE_ALARM;
+
+WEARABLE_ALARM mix[] =
+{
+	{ "accel fifo",   SEC(1) / 4,   3, SEC(1) / 10 },
+	{ "ble conn",     75,          11, 2 },
+	{ "heart rate",   SEC(1),       7, 20 },
+	{ "step flush",   SEC(5),      13, 100 },
+	{ "battery",      SEC(30),     19, ALARM_DEFERRABLE },
+	{ "ui clock",     SEC(60),     17, ALARM_DEFERRABLE },
+	{ "cloud sync",   SEC(300),    23, SEC(30) },
+};
+
+#define N_MIX	(sizeof(mix) / sizeof(mix[0]))
+
+UINT32 tid_ctrl;
+
+void wearable_alarm(UINT32 i)
+{
+	mix[i].runs++;
+	nos_delay_us(100);
+}
+
+void report(const char *title)
+{
+	NOS_VTIME_STATS s;
+	UINT32 i;
+
+	nos_vtime_get_stats(&s);
+	uart_printf("%s: %u wakeups\n", title, s.wakeups);
+	for (i = 0; i < N_MIX; i++)
+	{
+		uart_printf("   %-10s runs %5u\n", mix[i].name, mix[i].runs);
+		mix[i].runs = 0;
+	}
+	nos_vtime_reset_stats();
+}
+
+void ctrl_task(void *args)
+{
+	UINT32 i;
+
+	thread_sleep(SEC(3600));
+	report("exact expiries, 1h");
+
+	for (i = 0; i < N_MIX; i++)
+	{
+		alarm_stop(mix[i].alid);
+		alarm_set_slack(mix[i].alid, mix[i].slack);
+		alarm_start(mix[i].alid);
+	}
+
+	thread_sleep(SEC(3600));
+	report("slack + deferrable, 1h");
+}
+
+void app_init(void)
+{
+	UINT32 i;
+
+	for (i = 0; i < N_MIX; i++)
+	{
+		alarm_create(wearable_alarm, i, mix[i].phase, mix[i].period, &mix[i].alid);
+		alarm_start(mix[i].alid);
+	}
+
+	thread_create(ctrl_task, NULL, 0, PRIORITY_HIGH, FIFO, &tid_ctrl);
+	thread_activate(tid_ctrl);
+}
@@ -0,0 +1,130 @@
+//========================================================================
+// File		: edf_bench.c
+// Description : Fixed priorities versus earliest deadline first (linux_sim
+//		 with SIM_VIRTUAL_TIME). Twelve periodic threads load the
+//		 CPU to 96%. The first minute runs them at rate monotonic
+//		 priorities on the bitmap scheduler, the second minute in
+//		 the EDF class; deadline misses and context switches of both
+//		 minutes are compared.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include "nos.h"
+#include "vtime.h"
+
+typedef struct
+{
+	UINT32 period;		// ticks, also the relative deadline
+	UINT32 wcet_us;		// work of each job
+	UINT32 tid;
+	UINT32 jobs;
+} EDF_BENCH_TASK;
+
+// sorted by period: the index gives the rate monotonic priority
+EDF_BENCH_TASK set[] =
+{
+	{  7,  5600 },
+	{  9,  7200 },
+	{ 11,  8800 },
+	{ 13, 10400 },
+	{ 17, 13600 },
+	{ 19, 15200 },
+	{ 23, 18400 },
+	{ 29, 23200 },
+	{ 31, 24800 },
+	{ 37, 29600 },
+	{ 41, 32800 },
+	{ 47, 37600 },
+};
+
+#define N_SET		(sizeof(set) / sizeof(set[0]))
+#define RM_PRIORITY(i)	(CONFIG_EDF_PRIORITY - 1 - (i))	// below the EDF class
+
+UINT32 tid_ctrl;
+
+void job_task(void *args)
+{
+	EDF_BENCH_TASK *t = (EDF_BENCH_TASK *) args;
+
+	while (1)
+	{
+		nos_delay_us(t->wcet_us);
+		t->jobs++;
+		thread_wait_next_period();
+	}
+}
+
+void start_set(BOOL edf)
+{
+	UINT32 i;
+
+	for (i = 0; i < N_SET; i++)
+	{
+		set[i].jobs = 0;
+		thread_create_periodic(job_task, &set[i], 0, RM_PRIORITY(i), set[i].period, 0, &set[i].tid);
+		if (edf)
+		{
+			thread_set_edf(set[i].tid);
+		}
+	}
+	nos_vtime_reset_stats();
+
+	// every thread is released at the same tick
+	for (i = 0; i < N_SET; i++)
+	{
+		thread_activate(set[i].tid);
+	}
+}
+
+void stop_set(const char *title)
+{
+	NOS_VTIME_STATS s;
+	UINT32 i, tid, jobs = 0, misses = 0, overruns = 0, switches = 0;
+
+	nos_vtime_get_stats(&s);
+	for (i = 0; i < N_SET; i++)
+	{
+		thread_terminate(set[i].tid);
+	}
+
+	uart_printf("%s:\n", title);
+	for (i = 0; i < N_SET; i++)
+	{
+		tid = set[i].tid;
+		uart_printf("   T=%3u0 ms C=%5u us  jobs %5u, misses %5u, overruns %5u, max response %6u us\n",
+			    set[i].period, set[i].wcet_us, set[i].jobs,
+			    get_thread_deadline_miss_count(tid), get_thread_overrun_count(tid),
+			    get_thread_max_response_us(tid));
+		jobs += set[i].jobs;
+		misses += get_thread_deadline_miss_count(tid);
+		overruns += get_thread_overrun_count(tid);
+		switches += get_thread_switch_count(tid) + get_thread_preempt_count(tid);
+	}
+	uart_printf("   total jobs %u, deadline misses %u, overruns %u\n", jobs, misses, overruns);
+	uart_printf("   context switches %u (%u preempting ticks)\n", switches, s.ctx_switches);
+}
+
+void ctrl_task(void *args)
+{
+	start_set(FALSE);
+	thread_sleep(SEC(60));
+	stop_set("rate monotonic (bitmap scheduler), 60 s");
+
+	start_set(TRUE);
+	thread_sleep(SEC(60));
+	stop_set("EDF class, 60 s");
+}
+
+void app_init(void)
+{
+	UINT32 i, u = 0;
+
+	for (i = 0; i < N_SET; i++)
+	{
+		u += set[i].wcet_us / set[i].period;	// per mille of a 10 ms tick
+	}
+	uart_printf("%u periodic threads, utilization %u.%u%%\n", N_SET, u / 100, u % 100 / 10);
+
+	thread_create(ctrl_task, NULL, 0, CONFIG_EDF_PRIORITY + 1, FIFO, &tid_ctrl);
+	thread_activate(tid_ctrl);
+}
@@ -0,0 +1,210 @@
+//========================================================================
+// File		: heap_bench.c
+// Description : TLSF heap (HEAP_TLSF) versus the C library allocator the
+//		 heap used before, on the same randomized alloc/free trace
+//		 (linux_sim with SIM_VIRTUAL_TIME, so no tick signal disturbs
+//		 the timing). Both run inside the heap critical section.
+//		 Latency percentiles of each call and the fragmentation left
+//		 by the trace are printed.
+//========================================================================
+// Copyright 2016-2025, ETRI
+//========================================================================
+#include <stdlib.h>
+#include <malloc.h>
+#include <time.h>
+#include "nos.h"
+
+#define N_SLOT		1024		// live blocks at most
+#define N_WARMUP	100000		// untimed operations first
+#define N_OP		400000		// timed operations
+
+typedef struct
+{
+	void	*ptr;
+	UINT32	len;
+} SLOT;
+
+SLOT slot[N_SLOT];
+UINT32 alloc_ns[N_OP], free_ns[N_OP];
+UINT32 n_alloc, n_free, n_fail;
+UINT32 live, peak_live;
+UINT32 seed;
+
+UINT32 tid_bench;
+
+static UINT32 bench_rand(void)
+{
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+// 70% 8..128 bytes, 25% up to 1 KB, 5% up to 8 KB
+static UINT32 bench_size(void)
+{
+	UINT32 r = bench_rand() % 100;
+
+	if (r < 70)
+	{
+		return 8 + bench_rand() % 121;
+	}
+	else if (r < 95)
+	{
+		return 129 + bench_rand() % 896;
+	}
+	return 1025 + bench_rand() % 7168;
+}
+
+static UINT64 now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (UINT64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void *libc_malloc(UINT32 len)
+{
+	void *ptr;
+
+	NOS_ENTER_CRITICAL_SECTION();
+	ptr = (malloc)(len);	// api.h maps malloc() to nos_malloc()
+	NOS_EXIT_CRITICAL_SECTION();
+	return ptr;
+}
+
+static void libc_free(void *ptr)
+{
+	NOS_ENTER_CRITICAL_SECTION();
+	(free)(ptr);
+	NOS_EXIT_CRITICAL_SECTION();
+}
+
+// a random slot is filled if empty, emptied otherwise
+static void run_trace(void *(*alloc)(UINT32), void (*release)(void *), UINT32 ops, BOOL timed)
+{
+	UINT32 i, k, len;
+	UINT64 t0;
+	void *p;
+
+	for (i = 0; i < ops; i++)
+	{
+		k = bench_rand() % N_SLOT;
+		if (slot[k].ptr == NULL)
+		{
+			len = bench_size();
+			t0 = now_ns();
+			p = alloc(len);
+			if (timed)
+			{
+				alloc_ns[n_alloc++] = (UINT32)(now_ns() - t0);
+			}
+			if (p == NULL)
+			{
+				n_fail++;
+				continue;
+			}
+			((UINT8 *)p)[0] = ((UINT8 *)p)[len - 1] = (UINT8)k;
+			slot[k].ptr = p;
+			slot[k].len = len;
+			live += len;
+			if (live > peak_live)
+			{
+				peak_live = live;
+			}
+		}
+		else
+		{
+			t0 = now_ns();
+			release(slot[k].ptr);
+			if (timed)
+			{
+				free_ns[n_free++] = (UINT32)(now_ns() - t0);
+			}
+			slot[k].ptr = NULL;
+			live -= slot[k].len;
+		}
+	}
+}
+
+static void clear_trace(void (*release)(void *))
+{
+	UINT32 k;
+
+	for (k = 0; k < N_SLOT; k++)
+	{
+		if (slot[k].ptr != NULL)
+		{
+			release(slot[k].ptr);
+			slot[k].ptr = NULL;
+		}
+	}
+	live = 0;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+	UINT32 x = *(const UINT32 *)a, y = *(const UINT32 *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void print_percentiles(const char *name, UINT32 *ns, UINT32 n)
+{
+	qsort(ns, n, sizeof(UINT32), cmp_u32);
+	uart_printf("   %-6s %6u calls: p50 %5u  p90 %5u  p99 %5u  p99.9 %6u  max %7u ns\n", name, n,
+		    ns[n / 2], ns[n * 9 / 10], ns[n * 99 / 100], ns[n * 999 / 1000], ns[n - 1]);
+}
+
+static void bench(const char *title, void *(*alloc)(UINT32), void (*release)(void *))
+{
+	seed = 2025;
+	n_alloc = n_free = n_fail = 0;
+	live = peak_live = 0;
+
+	run_trace(alloc, release, N_WARMUP, FALSE);
+	run_trace(alloc, release, N_OP, TRUE);
+
+	uart_printf("%s:\n", title);
+	print_percentiles("alloc", alloc_ns, n_alloc);
+	print_percentiles("free", free_ns, n_free);
+}
+
+void bench_task(void *args)
+{
+	TLSF_STATS s;
+	struct mallinfo2 mi;
+	UINT64 t0;
+	UINT32 i, timer_ns;
+
+	/* cost of the time stamps themselves */
+	t0 = now_ns();
+	for (i = 0; i < 100000; i++)
+	{
+		now_ns();
+	}
+	timer_ns = (UINT32)((now_ns() - t0) / 100000);
+	uart_printf("trace: %u slots, %u + %u operations; time stamp cost %u ns (included below)\n",
+		    N_SLOT, N_WARMUP, N_OP, timer_ns);
+
+	bench("TLSF (nos_malloc/nos_free)", nos_malloc, nos_free);
+	nos_heap_get_stats(&s);
+	uart_printf("   live %u bytes (peak %u), heap %u bytes, used %u (peak %u), failed %u\n",
+		    live, peak_live, s.total, s.used, s.max_used, n_fail);
+	uart_printf("   free %u bytes, largest free block %u, fragmentation %u%%\n",
+		    s.free, s.largest_free, s.free ? 100 - (UINT32)((UINT64)s.largest_free * 100 / s.free) : 0);
+	clear_trace(nos_free);
+
+	bench("C library (malloc/free)", libc_malloc, libc_free);
+	mi = mallinfo2();
+	uart_printf("   live %u bytes (peak %u), heap %u bytes, free %u bytes, failed %u\n",
+		    live, peak_live, (UINT32)mi.arena, (UINT32)mi.fordblks, n_fail);
+	clear_trace(libc_free);
+}
+
+void app_init(void)
+{
+	uart_printf("\n\r*** Heap latency and fragmentation ***\n\r");
+
+	thread_create(bench_task, NULL, 0, PRIORITY_NORMAL, FIFO, &tid_bench);
+	thread_activate(tid_bench);
+}
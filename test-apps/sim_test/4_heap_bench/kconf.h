@@ -0,0 +1,52 @@
+/*
+ * Automatically generated C config: don't edit
+ */
+#define AUTOCONF_INCLUDED
+#define CONFIG_MCU_NAME "posix"
+#define GCC_TOOLCHAIN 1
+
+/*
+ * Platform: Linux host simulator
+ */
+#define CONFIG_PLATFORM_NAME "linux_sim"
+#define UART_M 1
+#define UART1_STDIO 1
+#undef UART1_DISABLED
+#define UART1 1
+#define PWM_M 1
+#define SIM_VIRTUAL_TIME 1
+#define CONFIG_SIM_VIRTUAL_TIME_LIMIT 0
+
+/*
+ * Kernel
+ */
+#define KERNEL_M 1
+#define SCHED_PERIOD_10 1
+#undef SCHED_PERIOD_32
+#undef SCHED_PERIOD_100
+#undef TASKQ_LEN_8
+#undef TASKQ_LEN_16
+#define TASKQ_LEN_32 1
+#undef TASKQ_LEN_64
+#undef TASKQ_LEN_128
+#define USER_TIMER_M 1
+#define THREAD_M 1
+#define ENABLE_SCHEDULING 1
+#undef EDF_SCHED
+#undef THREAD_EXT_M
+#undef SEM_M
+#undef MSGQ_M
+#define HEAP_TLSF 1
+#define CONFIG_HEAP_TLSF_GROW 4096
+#undef HEAP_TLSF_CHECK
+
+/*
+ * Debugging
+ */
+#undef NOS_DEBUG_M
+#undef HEAP_DEBUG
+
+/*
+ * Storage
+ */
+#undef CFD_M
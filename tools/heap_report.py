@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2006-2015  Electronics and Telecommunications Research Institute (ETRI)
+#
+# This file is subject to the terms and conditions of the GNU General Public License V3
+# See the file LICENSE in the top level directory for more details.
+#
+# This file is part of the NanoQplus3 operating system.
+#
+"""Reads a heap profiler report (HEAP_PROFILE, nos/lib/heap_profile.h) from a
+capture of the UART output, symbolizes its call sites against the ELF file
+of the application and prints the top allocators, the oldest live blocks
+and the fragmentation of each heap.
+
+    heap_report.py capture.bin app.elf [--top N] [--blocks N] [--addr2line TOOL]
+
+The last complete report of the capture is used: a report is taken only
+if its END record's checksum matches, so one cut off by the end of the
+capture (or a stray magic) falls back to the report before it. Other
+output around the reports is skipped.
+"""
+
+import argparse
+import os
+import shutil
+import struct
+import subprocess
+import sys
+
+MAGIC = b"NHP1"
+
+REC_END, REC_SUMMARY, REC_HEAP, REC_SITE, REC_BLOCK = range(5)
+REC_WORDS = {REC_END: 1, REC_SUMMARY: 9, REC_HEAP: 7, REC_SITE: 6, REC_BLOCK: 4}
+
+SUMMARY_FIELDS = ("now_ms", "allocs", "frees", "alloc_fail", "untracked",
+                  "live_count", "live_bytes", "peak_count", "peak_bytes")
+HEAP_FIELDS = ("region", "total", "used", "max_used", "free", "largest_free", "fail")
+SITE_FIELDS = ("caller", "allocs", "alloc_fail", "live_count", "live_bytes", "peak_bytes")
+BLOCK_FIELDS = ("ptr", "len", "caller", "age_ms")
+
+REGION_NAMES = ("SRAM", "CCM", "BKPSRAM")
+
+EM_ARM = 40
+
+
+def parse_report_at(data, start):
+    """Returns (summary, heaps, sites, blocks) of the report whose magic is at start."""
+    pos = start + len(MAGIC)
+    summary, heaps, sites, blocks = None, [], [], []
+
+    while True:
+        if pos >= len(data):
+            raise ValueError("report truncated")
+        tag = data[pos]
+        if tag not in REC_WORDS:
+            raise ValueError("bad record tag %d at offset %d" % (tag, pos))
+        n = REC_WORDS[tag]
+        end = pos + 1 + 4 * n
+        if end > len(data):
+            raise ValueError("report truncated")
+        words = struct.unpack("<%dI" % n, data[pos + 1:end])
+
+        if tag == REC_END:
+            checksum = sum(data[start + len(MAGIC):pos]) & 0xFFFFFFFF
+            if checksum != words[0]:
+                raise ValueError("checksum mismatch (0x%08x, expected 0x%08x)" % (checksum, words[0]))
+            break
+        elif tag == REC_SUMMARY:
+            summary = dict(zip(SUMMARY_FIELDS, words))
+        elif tag == REC_HEAP:
+            heaps.append(dict(zip(HEAP_FIELDS, words)))
+        elif tag == REC_SITE:
+            sites.append(dict(zip(SITE_FIELDS, words)))
+        else:
+            blocks.append(dict(zip(BLOCK_FIELDS, words)))
+        pos = end
+
+    if summary is None:
+        raise ValueError("report without a summary")
+    return summary, heaps, sites, blocks
+
+
+def parse_report(data):
+    """Returns (summary, heaps, sites, blocks) of the last report in data that is complete."""
+    end = len(data)
+    skipped = []
+
+    while True:
+        start = data.rfind(MAGIC, 0, end)
+        if start < 0:
+            if skipped:
+                raise ValueError("no complete heap report in the capture (last one: %s)" % skipped[0])
+            raise ValueError("no heap report in the capture")
+        try:
+            report = parse_report_at(data, start)
+        except ValueError as e:
+            skipped.append("%s, at offset %d" % (e, start))
+            end = start
+            continue
+        for reason in skipped:
+            print("warning: report skipped (%s)" % reason, file=sys.stderr)
+        return report
+
+
+def elf_machine(path):
+    with open(path, "rb") as f:
+        ident = f.read(20)
+    if ident[:4] != b"\x7fELF":
+        raise ValueError("%s is not an ELF file" % path)
+    return struct.unpack("<H" if ident[5] == 1 else ">H", ident[18:20])[0]
+
+
+def symbolize(elf, addrs, tool):
+    """Maps each return address to 'function (file:line)'."""
+    names = {a: "0x%08x" % a if a else "(other call sites)" for a in addrs}
+    if not addrs or tool is None:
+        return names
+
+    # thumb bit off, one byte back: inside the call instruction
+    query = [(a & ~1) - 1 if a else 0 for a in addrs]
+    try:
+        out = subprocess.run([tool, "-f", "-C", "-e", elf] + ["0x%x" % q for q in query],
+                             capture_output=True, text=True, check=True).stdout.splitlines()
+    except (OSError, subprocess.CalledProcessError) as e:
+        print("warning: %s failed (%s); call sites are not symbolized" % (tool, e), file=sys.stderr)
+        return names
+
+    for i, a in enumerate(addrs):
+        if a == 0:
+            continue
+        func, line = out[2 * i], os.path.basename(out[2 * i + 1])
+        if func != "??":
+            names[a] = "%s (%s)" % (func, line)
+    return names
+
+
+def find_addr2line(elf, tool):
+    if tool:
+        return tool
+    candidates = ["arm-none-eabi-addr2line"] if elf_machine(elf) == EM_ARM else []
+    for c in candidates + ["addr2line"]:
+        if shutil.which(c):
+            return c
+    print("warning: no addr2line found; call sites are not symbolized", file=sys.stderr)
+    return None
+
+
+def fragmentation(heap):
+    """0 when the free bytes are one block, towards 100% as they scatter."""
+    if heap["free"] == 0:
+        return 0.0
+    return 100.0 * (1 - heap["largest_free"] / heap["free"])
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Symbolize and summarize a heap profiler report.")
+    ap.add_argument("capture", help="raw capture of the UART output")
+    ap.add_argument("elf", help="ELF file of the application")
+    ap.add_argument("--top", type=int, default=10, help="call sites to list (default 10)")
+    ap.add_argument("--blocks", type=int, default=10, help="oldest live blocks to list (default 10)")
+    ap.add_argument("--addr2line", help="addr2line of the target toolchain")
+    args = ap.parse_args()
+
+    with open(args.capture, "rb") as f:
+        data = f.read()
+    try:
+        summary, heaps, sites, blocks = parse_report(data)
+    except ValueError as e:
+        sys.exit("heap_report: %s" % e)
+
+    try:
+        tool = find_addr2line(args.elf, args.addr2line)
+    except (OSError, ValueError) as e:
+        sys.exit("heap_report: %s" % e)
+    names = symbolize(args.elf, sorted({s["caller"] for s in sites}), tool)
+
+    s = summary
+    print("heap report at %.1f s: %u allocs, %u frees, %u failed, %u untracked"
+          % (s["now_ms"] / 1000.0, s["allocs"], s["frees"], s["alloc_fail"], s["untracked"]))
+    print("live: %u blocks, %u bytes (peak %u blocks, %u bytes)"
+          % (s["live_count"], s["live_bytes"], s["peak_count"], s["peak_bytes"]))
+
+    # misses: allocations that found no free block (the main heap then grows)
+    print("\n%-8s %9s %9s %9s %9s %9s %6s %6s"
+          % ("heap", "total", "used", "peak", "free", "largest", "frag", "misses"))
+    for h in heaps:
+        name = REGION_NAMES[h["region"]] if len(heaps) > 1 and h["region"] < len(REGION_NAMES) else "heap"
+        print("%-8s %9u %9u %9u %9u %9u %5.1f%% %6u"
+              % (name, h["total"], h["used"], h["max_used"], h["free"], h["largest_free"],
+                 fragmentation(h), h["fail"]))
+
+    print("\ntop call sites by live bytes:")
+    print("%10s %7s %10s %8s %6s  %s" % ("live bytes", "blocks", "peak", "allocs", "failed", "call site"))
+    for site in sorted(sites, key=lambda x: (x["live_bytes"], x["peak_bytes"]), reverse=True)[:args.top]:
+        print("%10u %7u %10u %8u %6u  %s"
+              % (site["live_bytes"], site["live_count"], site["peak_bytes"], site["allocs"],
+                 site["alloc_fail"], names[site["caller"]]))
+
+    print("\noldest live blocks:")
+    print("%10s %8s %10s  %s" % ("age (s)", "bytes", "address", "call site"))
+    for b in sorted(blocks, key=lambda x: x["age_ms"], reverse=True)[:args.blocks]:
+        print("%10.1f %8u 0x%08x  %s"
+              % (b["age_ms"] / 1000.0, b["len"], b["ptr"], names.get(b["caller"], "0x%08x" % b["caller"])))
+
+
+if __name__ == "__main__":
+    main()